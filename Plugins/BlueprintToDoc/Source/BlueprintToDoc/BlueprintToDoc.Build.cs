@@ -1,5 +1,6 @@
 ﻿// Copyright 1998-2017 Epic Games, Inc. All Rights Reserved.
 
+using System.IO;
 using UnrealBuildTool;
 
 public class BlueprintToDoc : ModuleRules
@@ -41,13 +42,28 @@ public class BlueprintToDoc : ModuleRules
 				"Engine",
 				"Slate",
 				"SlateCore",
-				"BlueprintGraph"
+				"BlueprintGraph",
+				"AnimGraph",
+				"UMG",
+				"UMGEditor",
+				"UnrealEd",
+				"Sockets",
+				"Networking"
 
 				// ... add private dependencies that you statically link with here ...	
 			}
 			);
 
 
+		// SQLiteCoreプラグインがあればドキュメントのデータベースを出力できるようにする
+		bool bWithSQLite = Directory.Exists(Path.Combine(EngineDirectory, "Plugins", "Runtime", "Database", "SQLiteCore"));
+		if (bWithSQLite)
+		{
+			PrivateDependencyModuleNames.Add("SQLiteCore");
+		}
+		PublicDefinitions.Add("WITH_BLUEPRINTTODOC_SQLITE=" + (bWithSQLite ? "1" : "0"));
+
+
 		DynamicallyLoadedModuleNames.AddRange(
 			new string[]
 			{
@@ -0,0 +1,304 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "BlueprintToDocArena.h"
+#include "BlueprintToDocHTMLWriter.h"
+
+#include "Misc/AutomationTest.h"
+#include "Misc/ScopeLock.h"
+#include "HAL/ThreadSafeBool.h"
+#include "HAL/ThreadSafeCounter.h"
+
+
+// 全てのスレッドの集計(スコープを抜けるときにだけ加える)
+static FCriticalSection StatsLock;
+static FBlueprintToDocArena::FStats TotalStats;
+// ヒープからの確保はスコープの外やスレッドをまたぐので別に数える
+static FThreadSafeCounter HeapAllocationCounter;
+static FThreadSafeBool bArenaEnabled(true);
+
+
+FBlueprintToDocArena::FBlueprintToDocArena()
+	: ScopeDepth(0)
+	, bScopeEnabled(false)
+	, Top(nullptr)
+	, End(nullptr)
+	, LastAllocation(nullptr)
+{
+}
+
+FBlueprintToDocArena::~FBlueprintToDocArena()
+{
+	ReleaseAll();
+}
+
+void* FBlueprintToDocArena::Allocate(SIZE_T Size, uint32 Alignment)
+{
+	if(!IsActive())
+	{
+		return nullptr;
+	}
+
+	++Stats.AllocationCount;
+	uint8* Result = Align(Top, Alignment);
+	if(Top == nullptr || Result + Size > End)
+	{
+		// 残りは捨てて新しいブロックにする
+		const SIZE_T NewBlockSize = FMath::Max<SIZE_T>(BlockSize, Size + Alignment);
+		uint8* Block = (uint8*)FMemory::Malloc(NewBlockSize);
+		Blocks.Add(Block);
+		++Stats.BlockCount;
+		Stats.BlockBytes += NewBlockSize;
+
+		End = Block + NewBlockSize;
+		Result = Align(Block, Alignment);
+	}
+	Top = Result + Size;
+	LastAllocation = Result;
+	return Result;
+}
+
+void* FBlueprintToDocArena::Reallocate(void* Original, SIZE_T CopySize, SIZE_T Size, uint32 Alignment)
+{
+	// 描画中に伸びていくのはほぼ最後に確保した配列なので、その場で伸ばせることが多い
+	if(Original != nullptr && Original == LastAllocation && (uint8*)Original + Size <= End)
+	{
+		++Stats.AllocationCount;
+		Top = (uint8*)Original + Size;
+		return Original;
+	}
+
+	void* Result = Allocate(Size, Alignment);
+	if(Result != nullptr && Original != nullptr)
+	{
+		FMemory::Memcpy(Result, Original, FMath::Min(CopySize, Size));
+	}
+	return Result;
+}
+
+FBlueprintToDocArena::FStats FBlueprintToDocArena::GetStats()
+{
+	FScopeLock Lock(&StatsLock);
+	FStats Result = TotalStats;
+	Result.HeapAllocationCount = HeapAllocationCounter.GetValue();
+	return Result;
+}
+
+void FBlueprintToDocArena::ResetStats()
+{
+	FScopeLock Lock(&StatsLock);
+	TotalStats = FStats();
+	HeapAllocationCounter.Reset();
+}
+
+void FBlueprintToDocArena::SetEnabled(bool bInEnabled)
+{
+	bArenaEnabled = bInEnabled;
+}
+
+void FBlueprintToDocArena::CountHeapAllocation()
+{
+	HeapAllocationCounter.Increment();
+}
+
+void FBlueprintToDocArena::ReleaseAll()
+{
+	for(uint8* Block : Blocks)
+	{
+		FMemory::Free(Block);
+	}
+	Blocks.Empty();
+	Top = nullptr;
+	End = nullptr;
+	LastAllocation = nullptr;
+
+	if(Stats.AllocationCount > 0)
+	{
+		FScopeLock Lock(&StatsLock);
+		TotalStats.AllocationCount += Stats.AllocationCount;
+		TotalStats.BlockCount += Stats.BlockCount;
+		TotalStats.BlockBytes += Stats.BlockBytes;
+	}
+	Stats = FStats();
+}
+
+
+FBlueprintToDocArenaScope::FBlueprintToDocArenaScope()
+	: Arena(FBlueprintToDocArena::Get())
+{
+	if(Arena.ScopeDepth++ == 0)
+	{
+		Arena.bScopeEnabled = bArenaEnabled;
+	}
+}
+
+FBlueprintToDocArenaScope::~FBlueprintToDocArenaScope()
+{
+	check(Arena.ScopeDepth > 0);
+	if(--Arena.ScopeDepth == 0)
+	{
+		Arena.ReleaseAll();
+	}
+}
+
+
+void FBlueprintToDocArenaAllocator::ForAnyElementType::MoveToEmpty(ForAnyElementType& Other)
+{
+	checkSlow(this != &Other);
+	if(Data && !bArenaData)
+	{
+		FMemory::Free(Data);
+	}
+	Data = nullptr;
+	AllocatedBytes = 0;
+	bArenaData = false;
+
+	if(Other.bArenaData && !bUseArena)
+	{
+		// スコープの外で作った配列にはアリーナのメモリを渡さない
+		Data = (FScriptContainerElement*)FMemory::Malloc(Other.AllocatedBytes);
+		FMemory::Memcpy(Data, Other.Data, Other.AllocatedBytes);
+		AllocatedBytes = Other.AllocatedBytes;
+	}
+	else
+	{
+		Data = Other.Data;
+		AllocatedBytes = Other.AllocatedBytes;
+		bArenaData = Other.bArenaData;
+	}
+	Other.Data = nullptr;
+	Other.AllocatedBytes = 0;
+	Other.bArenaData = false;
+}
+
+void FBlueprintToDocArenaAllocator::ForAnyElementType::ResizeAllocation(int32 PreviousNumElements, int32 NumElements, SIZE_T NumBytesPerElement)
+{
+	if(!bArenaData && !(Data == nullptr && bUseArena))
+	{
+		// スコープの外で作った配列はヒープから確保する
+		if(Data || NumElements)
+		{
+			Data = (FScriptContainerElement*)FMemory::Realloc(Data, NumElements * NumBytesPerElement);
+		}
+		if(NumElements > 0)
+		{
+			FBlueprintToDocArena::CountHeapAllocation();
+		}
+		AllocatedBytes = NumElements * NumBytesPerElement;
+		return;
+	}
+
+	FBlueprintToDocArena& Arena = FBlueprintToDocArena::Get();
+	checkf(Arena.IsActive(), TEXT("Arena allocation used outside of FBlueprintToDocArenaScope"));
+	if(NumElements == 0)
+	{
+		// まとめて解放するので捨てるだけ
+		Data = nullptr;
+		AllocatedBytes = 0;
+		bArenaData = false;
+		return;
+	}
+	Data = (FScriptContainerElement*)Arena.Reallocate(Data, PreviousNumElements * NumBytesPerElement, NumElements * NumBytesPerElement, 16);
+	AllocatedBytes = NumElements * NumBytesPerElement;
+	bArenaData = true;
+}
+
+
+/**
+ *  テスト実行 アリーナ
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBlueprintToDocArenaTest, "BlueprintToDoc.Arena", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter);
+bool FBlueprintToDocArenaTest::RunTest(const FString& Parameters)
+{
+	// スコープの外ではヒープから確保する
+	FBlueprintToDocUTF8Bytes HeapBytes;
+	HeapBytes.Add(1);
+	TestFalse(TEXT("InactiveOutsideScope"), FBlueprintToDocArena::Get().IsActive());
+
+	// スコープの外で作り、スコープの中で初めて追加するもの
+	FBlueprintToDocHTMLWriter LongLivedWriter;
+	FBlueprintToDocUTF8Bytes MovedBytes;
+
+	FBlueprintToDocArena::ResetStats();
+	{
+		FBlueprintToDocArenaScope Scope;
+		TestTrue(TEXT("ActiveInScope"), FBlueprintToDocArena::Get().IsActive());
+
+		// 交互に伸ばしても内容は保たれる
+		FBlueprintToDocUTF8Bytes First;
+		FBlueprintToDocUTF8Bytes Second;
+		for(int32 Index = 0; Index < 100000; ++Index)
+		{
+			First.Add((uint8)Index);
+			if(Index % 3 == 0)
+			{
+				Second.Add((uint8)(Index * 7));
+			}
+		}
+		bool bSame = First.Num() == 100000 && Second.Num() == 33334;
+		for(int32 Index = 0; bSame && Index < First.Num(); ++Index)
+		{
+			bSame = First[Index] == (uint8)Index;
+		}
+		for(int32 Index = 0; bSame && Index < Second.Num(); ++Index)
+		{
+			bSame = Second[Index] == (uint8)(Index * 3 * 7);
+		}
+		TestTrue(TEXT("Contents"), bSame);
+
+		// 入れ子のスコープでは解放しない
+		{
+			FBlueprintToDocArenaScope NestedScope;
+		}
+		TestTrue(TEXT("ActiveAfterNestedScope"), FBlueprintToDocArena::Get().IsActive() && First[99999] == (uint8)99999);
+
+		// スコープの外で確保した配列はヒープのまま伸ばせる
+		HeapBytes.AddZeroed(1000);
+
+		// スコープの外で作った配列は空のままスコープに入ってもヒープから確保する
+		LongLivedWriter.Append("<td>long lived</td>");
+
+		// スコープの外で作った配列へのムーブはヒープにコピーする
+		FBlueprintToDocUTF8Bytes ScopedBytes;
+		ScopedBytes.Init(0xAB, 1000);
+		MovedBytes = MoveTemp(ScopedBytes);
+	}
+	TestFalse(TEXT("InactiveAfterScope"), FBlueprintToDocArena::Get().IsActive());
+	TestEqual(TEXT("HeapBytes"), HeapBytes.Num(), 1001);
+
+	// 解放したメモリが使い回されても残っている
+	{
+		FBlueprintToDocArenaScope Scope;
+		FBlueprintToDocUTF8Bytes Overwrite;
+		Overwrite.Init(0xCD, 64 * 1024);
+	}
+	const ANSICHAR Expected[] = "<td>long lived</td>";
+	TestTrue(TEXT("LongLivedWriter"), LongLivedWriter.Num() == sizeof(Expected) - 1 && FMemory::Memcmp(LongLivedWriter.GetBytes().GetData(), Expected, sizeof(Expected) - 1) == 0);
+	bool bMovedSame = MovedBytes.Num() == 1000;
+	for(int32 Index = 0; bMovedSame && Index < MovedBytes.Num(); ++Index)
+	{
+		bMovedSame = MovedBytes[Index] == 0xAB;
+	}
+	TestTrue(TEXT("MovedOutOfScope"), bMovedSame);
+
+	const FBlueprintToDocArena::FStats Stats = FBlueprintToDocArena::GetStats();
+	TestTrue(TEXT("FewerBlocksThanAllocations"), Stats.BlockCount > 0 && Stats.BlockCount < Stats.AllocationCount);
+	FBlueprintToDocArena::ResetStats();
+
+	// 無効にするとスコープの中でもヒープから確保し、その回数を計測する
+	FBlueprintToDocArena::SetEnabled(false);
+	{
+		FBlueprintToDocArenaScope Scope;
+		TestFalse(TEXT("InactiveWhenDisabled"), FBlueprintToDocArena::Get().IsActive());
+		FBlueprintToDocUTF8Bytes Bytes;
+		for(int32 Index = 0; Index < 100000; ++Index)
+		{
+			Bytes.Add((uint8)Index);
+		}
+	}
+	FBlueprintToDocArena::SetEnabled(true);
+	const FBlueprintToDocArena::FStats DisabledStats = FBlueprintToDocArena::GetStats();
+	TestTrue(TEXT("HeapAllocationsWhenDisabled"), DisabledStats.AllocationCount == 0 && DisabledStats.HeapAllocationCount > 0);
+	FBlueprintToDocArena::ResetStats();
+
+	return true;
+}
@@ -0,0 +1,172 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/ThreadSingleton.h"
+
+/**
+ * ページの描画中の一時的なバッファを確保する線形アロケータ
+ * スレッドごとに持ち、FBlueprintToDocArenaScope を抜けるときにまとめて解放する
+ */
+class FBlueprintToDocArena : public TThreadSingleton<FBlueprintToDocArena>
+{
+public:
+	// 1つのブロックのサイズ(これより大きい確保はそのサイズのブロックにする)
+	static const SIZE_T BlockSize = 64 * 1024;
+
+	// 実行中に集計した確保の回数
+	struct FStats
+	{
+		// アリーナから確保、伸長した回数
+		int32 AllocationCount = 0;
+		// アリーナを使わない配列がヒープから確保、伸長した回数(計測した値。アリーナを無効にするとアリーナが無い場合の回数になる)
+		int32 HeapAllocationCount = 0;
+		// ブロックとしてヒープから確保した回数
+		int32 BlockCount = 0;
+		int64 BlockBytes = 0;
+	};
+
+	FBlueprintToDocArena();
+	~FBlueprintToDocArena();
+
+	// このスレッドでスコープの中にいて、アリーナが有効か
+	bool IsActive() const { return ScopeDepth > 0 && bScopeEnabled; }
+	// 確保する(スコープの外ではnullptr)
+	void* Allocate(SIZE_T Size, uint32 Alignment);
+	// 直前に確保したものならその場で伸縮し、そうでなければ確保し直して使用中の CopySize だけコピーする
+	void* Reallocate(void* Original, SIZE_T CopySize, SIZE_T Size, uint32 Alignment);
+
+	// 全てのスレッドの集計
+	static FStats GetStats();
+	static void ResetStats();
+
+	// 無効にするとスコープの中でもヒープから確保する(比較の計測用。次に一番外側のスコープに入ったときから反映する)
+	static void SetEnabled(bool bInEnabled);
+	// ヒープから確保した回数を加える
+	static void CountHeapAllocation();
+
+private:
+	friend class FBlueprintToDocArenaScope;
+
+	// 全てのブロックを解放して集計に加える
+	void ReleaseAll();
+
+	int32 ScopeDepth;
+	// 一番外側のスコープに入ったときに有効だったか
+	bool bScopeEnabled;
+	TArray<uint8*> Blocks;
+	uint8* Top;
+	uint8* End;
+	// 最後に確保した位置(その場で伸ばせるか判定する)
+	uint8* LastAllocation;
+	FStats Stats;
+};
+
+/**
+ * このスレッドのアリーナを有効にする
+ * 入れ子にした場合は一番外側のスコープを抜けたときに解放する
+ */
+class FBlueprintToDocArenaScope
+{
+public:
+	FBlueprintToDocArenaScope();
+	~FBlueprintToDocArenaScope();
+
+private:
+	FBlueprintToDocArena& Arena;
+};
+
+/**
+ * スコープの中で作った配列はアリーナから、外で作った配列はヒープから確保するTArrayのアロケータ
+ * どちらを使うかは配列を作ったときに決め、スコープの中で作った配列はスコープの外に持ち出さない
+ * スコープの外で作った配列にムーブした場合はヒープにコピーする
+ */
+class FBlueprintToDocArenaAllocator
+{
+public:
+	enum { NeedsElementType = false };
+	enum { RequireRangeCheck = true };
+
+	class ForAnyElementType
+	{
+	public:
+		ForAnyElementType()
+			: Data(nullptr)
+			, AllocatedBytes(0)
+			, bUseArena(FBlueprintToDocArena::Get().IsActive())
+			, bArenaData(false)
+		{
+		}
+
+		~ForAnyElementType()
+		{
+			if(Data && !bArenaData)
+			{
+				FMemory::Free(Data);
+			}
+		}
+
+		void MoveToEmpty(ForAnyElementType& Other);
+
+		FORCEINLINE FScriptContainerElement* GetAllocation() const
+		{
+			return Data;
+		}
+
+		void ResizeAllocation(int32 PreviousNumElements, int32 NumElements, SIZE_T NumBytesPerElement);
+
+		FORCEINLINE int32 CalculateSlackReserve(int32 NumElements, SIZE_T NumBytesPerElement) const
+		{
+			return DefaultCalculateSlackReserve(NumElements, NumBytesPerElement, false);
+		}
+		FORCEINLINE int32 CalculateSlackShrink(int32 NumElements, int32 NumAllocatedElements, SIZE_T NumBytesPerElement) const
+		{
+			return DefaultCalculateSlackShrink(NumElements, NumAllocatedElements, NumBytesPerElement, false);
+		}
+		FORCEINLINE int32 CalculateSlackGrow(int32 NumElements, int32 NumAllocatedElements, SIZE_T NumBytesPerElement) const
+		{
+			return DefaultCalculateSlackGrow(NumElements, NumAllocatedElements, NumBytesPerElement, false);
+		}
+
+		SIZE_T GetAllocatedSize(int32 NumAllocatedElements, SIZE_T NumBytesPerElement) const
+		{
+			return NumAllocatedElements * NumBytesPerElement;
+		}
+
+		bool HasAllocation()
+		{
+			return !!Data;
+		}
+
+	private:
+		ForAnyElementType(const ForAnyElementType&);
+		ForAnyElementType& operator=(const ForAnyElementType&);
+
+		FScriptContainerElement* Data;
+		SIZE_T AllocatedBytes;
+		// スコープの中で作られたか
+		bool bUseArena;
+		// Dataがアリーナのものなら解放しない
+		bool bArenaData;
+	};
+
+	template<typename ElementType>
+	class ForElementType : public ForAnyElementType
+	{
+	public:
+		FORCEINLINE ElementType* GetAllocation() const
+		{
+			return (ElementType*)ForAnyElementType::GetAllocation();
+		}
+	};
+};
+
+template <>
+struct TAllocatorTraits<FBlueprintToDocArenaAllocator> : TAllocatorTraitsBase<FBlueprintToDocArenaAllocator>
+{
+	enum { SupportsMove = true };
+};
+
+// HTMLを組み立てるUTF-8のバイト列
+typedef TArray<uint8, FBlueprintToDocArenaAllocator> FBlueprintToDocUTF8Bytes;
@@ -0,0 +1,175 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "BlueprintToDocBinary.h"
+#include "BlueprintToDoc.h"
+
+#include "HAL/PlatformFilemanager.h"
+#include "Async/MappedFileHandle.h"
+#include "Misc/FileHelper.h"
+
+
+FBlueprintToDocBinaryReader::FBlueprintToDocBinaryReader()
+	: MappedHandle(nullptr)
+	, MappedRegion(nullptr)
+	, Data(nullptr)
+	, DataSize(0)
+	, Header(nullptr)
+{
+}
+
+FBlueprintToDocBinaryReader::~FBlueprintToDocBinaryReader()
+{
+	Close();
+}
+
+bool FBlueprintToDocBinaryReader::Open(const TCHAR* Filename)
+{
+	Close();
+
+	// メモリマップ
+	MappedHandle = FPlatformFileManager::Get().GetPlatformFile().OpenMapped(Filename);
+	if(MappedHandle != nullptr)
+	{
+		MappedRegion = MappedHandle->MapRegion();
+	}
+
+	if(MappedRegion != nullptr)
+	{
+		Data = MappedRegion->GetMappedPtr();
+		DataSize = MappedRegion->GetMappedSize();
+	}
+	else
+	{
+		// メモリマップに対応していないプラットフォームでは一括で読み込む
+		if(!FFileHelper::LoadFileToArray(FallbackData, Filename))
+		{
+			Close();
+			return false;
+		}
+		Data = FallbackData.GetData();
+		DataSize = FallbackData.Num();
+	}
+
+	if(!Validate())
+	{
+		UE_LOG(LogBlueprintToDoc, Error, TEXT("Invalid Binary File:%s"), Filename);
+		Close();
+		return false;
+	}
+
+	Header = GetSection<FBlueprintToDocBinaryHeader>(0);
+	return true;
+}
+
+void FBlueprintToDocBinaryReader::Close()
+{
+	delete MappedRegion;
+	MappedRegion = nullptr;
+	delete MappedHandle;
+	MappedHandle = nullptr;
+	FallbackData.Empty();
+
+	Data = nullptr;
+	DataSize = 0;
+	Header = nullptr;
+}
+
+bool FBlueprintToDocBinaryReader::Validate() const
+{
+	if(Data == nullptr || DataSize < (int64)sizeof(FBlueprintToDocBinaryHeader))
+	{
+		return false;
+	}
+
+	const FBlueprintToDocBinaryHeader* FileHeader = GetSection<FBlueprintToDocBinaryHeader>(0);
+	if(FileHeader->Magic != BlueprintToDocBinary::Magic || FileHeader->Version != BlueprintToDocBinary::Version)
+	{
+		return false;
+	}
+
+	// 各セクションがファイル内に収まっているか
+	auto IsInside = [this](uint64 Offset, uint64 Size)
+	{
+		return Offset <= (uint64)DataSize && Size <= (uint64)DataSize - Offset;
+	};
+	return IsInside(FileHeader->BlueprintOffset, (uint64)FileHeader->BlueprintCount * sizeof(FBlueprintToDocBinaryBlueprint))
+		&& IsInside(FileHeader->GraphOffset, (uint64)FileHeader->GraphCount * sizeof(FBlueprintToDocBinaryGraph))
+		&& IsInside(FileHeader->PinOffset, (uint64)FileHeader->PinCount * sizeof(FBlueprintToDocBinaryPin))
+		&& IsInside(FileHeader->PropertyOffset, (uint64)FileHeader->PropertyCount * sizeof(FBlueprintToDocBinaryProperty))
+		&& IsInside(FileHeader->StringTableOffset, (uint64)FileHeader->StringCount * sizeof(FBlueprintToDocBinaryString))
+		&& IsInside(FileHeader->StringDataOffset, FileHeader->StringDataSize);
+}
+
+TArrayView<const FBlueprintToDocBinaryBlueprint> FBlueprintToDocBinaryReader::GetBlueprints() const
+{
+	if(Header == nullptr)
+	{
+		return TArrayView<const FBlueprintToDocBinaryBlueprint>();
+	}
+	return TArrayView<const FBlueprintToDocBinaryBlueprint>(GetSection<FBlueprintToDocBinaryBlueprint>(Header->BlueprintOffset), Header->BlueprintCount);
+}
+
+TArrayView<const FBlueprintToDocBinaryGraph> FBlueprintToDocBinaryReader::GetGraphs(const FBlueprintToDocBinaryBlueprint& Blueprint) const
+{
+	if(Header == nullptr || (uint64)Blueprint.FirstGraph + Blueprint.GraphCount > Header->GraphCount)
+	{
+		return TArrayView<const FBlueprintToDocBinaryGraph>();
+	}
+	return TArrayView<const FBlueprintToDocBinaryGraph>(GetSection<FBlueprintToDocBinaryGraph>(Header->GraphOffset) + Blueprint.FirstGraph, Blueprint.GraphCount);
+}
+
+TArrayView<const FBlueprintToDocBinaryProperty> FBlueprintToDocBinaryReader::GetProperties(const FBlueprintToDocBinaryBlueprint& Blueprint) const
+{
+	if(Header == nullptr || (uint64)Blueprint.FirstProperty + Blueprint.PropertyCount > Header->PropertyCount)
+	{
+		return TArrayView<const FBlueprintToDocBinaryProperty>();
+	}
+	return TArrayView<const FBlueprintToDocBinaryProperty>(GetSection<FBlueprintToDocBinaryProperty>(Header->PropertyOffset) + Blueprint.FirstProperty, Blueprint.PropertyCount);
+}
+
+TArrayView<const FBlueprintToDocBinaryPin> FBlueprintToDocBinaryReader::GetInputPins(const FBlueprintToDocBinaryGraph& Graph) const
+{
+	if(Header == nullptr || (uint64)Graph.FirstPin + Graph.InputCount > Header->PinCount)
+	{
+		return TArrayView<const FBlueprintToDocBinaryPin>();
+	}
+	return TArrayView<const FBlueprintToDocBinaryPin>(GetSection<FBlueprintToDocBinaryPin>(Header->PinOffset) + Graph.FirstPin, Graph.InputCount);
+}
+
+TArrayView<const FBlueprintToDocBinaryPin> FBlueprintToDocBinaryReader::GetOutputPins(const FBlueprintToDocBinaryGraph& Graph) const
+{
+	// 出力ピンは入力ピンの直後に並ぶ
+	if(Header == nullptr || (uint64)Graph.FirstPin + Graph.InputCount + Graph.OutputCount > Header->PinCount)
+	{
+		return TArrayView<const FBlueprintToDocBinaryPin>();
+	}
+	return TArrayView<const FBlueprintToDocBinaryPin>(GetSection<FBlueprintToDocBinaryPin>(Header->PinOffset) + Graph.FirstPin + Graph.InputCount, Graph.OutputCount);
+}
+
+const ANSICHAR* FBlueprintToDocBinaryReader::GetString(uint32 Index) const
+{
+	if(Header == nullptr || Index >= Header->StringCount)
+	{
+		return "";
+	}
+	const FBlueprintToDocBinaryString& String = GetSection<FBlueprintToDocBinaryString>(Header->StringTableOffset)[Index];
+	if((uint64)String.Offset + String.Length >= Header->StringDataSize)
+	{
+		return "";
+	}
+	return GetSection<ANSICHAR>(Header->StringDataOffset) + String.Offset;
+}
+
+int32 FBlueprintToDocBinaryReader::GetStringLength(uint32 Index) const
+{
+	if(Header == nullptr || Index >= Header->StringCount)
+	{
+		return 0;
+	}
+	const FBlueprintToDocBinaryString& String = GetSection<FBlueprintToDocBinaryString>(Header->StringTableOffset)[Index];
+	if((uint64)String.Offset + String.Length >= Header->StringDataSize)
+	{
+		return 0;
+	}
+	return String.Length;
+}
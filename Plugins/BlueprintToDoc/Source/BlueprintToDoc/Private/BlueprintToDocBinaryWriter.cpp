@@ -0,0 +1,181 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "BlueprintToDocBinaryWriter.h"
+#include "BlueprintToDoc.h"
+#include "BlueprintToDocUtil.h"
+
+#include "HAL/FileManager.h"
+#include "Templates/AlignmentTemplates.h"
+
+
+namespace BlueprintToDocBinaryWriter
+{
+	// セクションの境界
+	static const int64 SectionAlignment = 8;
+
+	// パディングを書き込んでセクションの先頭を揃える
+	static uint64 AlignSection(FArchive& Writer)
+	{
+		static const uint8 Zero[SectionAlignment] = {};
+		const int64 Position = Writer.Tell();
+		const int64 Padding = Align(Position, SectionAlignment) - Position;
+		Writer.Serialize((void*)Zero, Padding);
+		return (uint64)Writer.Tell();
+	}
+
+	template<typename T>
+	static uint64 WriteSection(FArchive& Writer, const TArray<T>& Records)
+	{
+		const uint64 Offset = AlignSection(Writer);
+		Writer.Serialize((void*)Records.GetData(), Records.Num() * sizeof(T));
+		return Offset;
+	}
+}
+
+bool FBlueprintToDocBinaryWriter::Export(const FDocument& Document, const FString& Path)
+{
+	using namespace BlueprintToDocBinaryWriter;
+
+	FBlueprintToDocBinaryWriter BinaryWriter;
+
+	// 空文字列は0番
+	BinaryWriter.AddString(FString());
+
+	for(const FBlueprintDocument& BlueprintDocument : Document.Blueprints)
+	{
+		FBlueprintToDocBinaryBlueprint Blueprint = {};
+		Blueprint.Name = BinaryWriter.AddString(BlueprintDocument.Name);
+		Blueprint.ToolTips = BinaryWriter.AddString(BlueprintDocument.ToolTips);
+		Blueprint.ParentName = BinaryWriter.AddString(BlueprintDocument.ParentName);
+		Blueprint.ContentPath = BinaryWriter.AddString(BlueprintDocument.ContentPath);
+		Blueprint.HardReferenceDiskSize = BlueprintDocument.HardReferenceDiskSize;
+		Blueprint.HardReferenceMemorySize = BlueprintDocument.HardReferenceMemorySize;
+		Blueprint.HardReferenceCount = BlueprintDocument.HardReferenceCount;
+		Blueprint.ReplicatedSize = BlueprintDocument.ReplicatedSize;
+		Blueprint.InstanceSize = BlueprintDocument.InstanceSize;
+
+		// グラフ
+		Blueprint.FirstGraph = BinaryWriter.Graphs.Num();
+		BinaryWriter.AddGraphs(BlueprintDocument.Events, BlueprintToDocBinary::EGraphKind::Event);
+		BinaryWriter.AddGraphs(BlueprintDocument.Macros, BlueprintToDocBinary::EGraphKind::Macro);
+		BinaryWriter.AddGraphs(BlueprintDocument.Functions, BlueprintToDocBinary::EGraphKind::Function);
+		Blueprint.GraphCount = BinaryWriter.Graphs.Num() - Blueprint.FirstGraph;
+
+		// プロパティ
+		Blueprint.FirstProperty = BinaryWriter.Properties.Num();
+		for(const FPropertyDocument& PropertyDocument : BlueprintDocument.Properties)
+		{
+			FBlueprintToDocBinaryProperty Property = {};
+			Property.Name = BinaryWriter.AddString(PropertyDocument.Name);
+			Property.Type = BinaryWriter.AddString(PropertyDocument.Type);
+			Property.Category = BinaryWriter.AddString(PropertyDocument.Category);
+			Property.DefaultValue = BinaryWriter.AddString(PropertyDocument.DefaultValue);
+			Property.ToolTips = BinaryWriter.AddString(PropertyDocument.ToolTips);
+			Property.LifetimeCondition = (uint32)PropertyDocument.LifetimeCondition;
+			Property.PropertyFlg = PropertyDocument.PropertyFlg;
+			Property.Size = PropertyDocument.Size;
+			Property.ReplicatedSize = PropertyDocument.ReplicatedSize;
+			BinaryWriter.Properties.Add(Property);
+		}
+		Blueprint.PropertyCount = BinaryWriter.Properties.Num() - Blueprint.FirstProperty;
+
+		BinaryWriter.Blueprints.Add(Blueprint);
+	}
+
+	TUniquePtr<FArchive> Writer(IFileManager::Get().CreateFileWriter(*Path));
+	if(!Writer)
+	{
+		UE_LOG(LogBlueprintToDoc, Error, TEXT("Failed Save File:%s"), *Path);
+		return false;
+	}
+
+	// ヘッダは最後に書き直す
+	FBlueprintToDocBinaryHeader Header = {};
+	Writer->Serialize(&Header, sizeof(Header));
+
+	Header.Magic = BlueprintToDocBinary::Magic;
+	Header.Version = BlueprintToDocBinary::Version;
+	Header.BlueprintCount = BinaryWriter.Blueprints.Num();
+	Header.GraphCount = BinaryWriter.Graphs.Num();
+	Header.PinCount = BinaryWriter.Pins.Num();
+	Header.PropertyCount = BinaryWriter.Properties.Num();
+	Header.StringCount = BinaryWriter.StringTable.Num();
+	Header.BlueprintOffset = WriteSection(*Writer, BinaryWriter.Blueprints);
+	Header.GraphOffset = WriteSection(*Writer, BinaryWriter.Graphs);
+	Header.PinOffset = WriteSection(*Writer, BinaryWriter.Pins);
+	Header.PropertyOffset = WriteSection(*Writer, BinaryWriter.Properties);
+	Header.StringTableOffset = WriteSection(*Writer, BinaryWriter.StringTable);
+	Header.StringDataOffset = WriteSection(*Writer, BinaryWriter.StringData);
+	Header.StringDataSize = BinaryWriter.StringData.Num();
+
+	Writer->Seek(0);
+	Writer->Serialize(&Header, sizeof(Header));
+
+	return Writer->Close();
+}
+
+uint32 FBlueprintToDocBinaryWriter::AddString(const FString& Value)
+{
+	if(const uint32* Index = StringIndices.Find(Value))
+	{
+		return *Index;
+	}
+
+	FTCHARToUTF8 ValueUTF8(*Value, Value.Len());
+
+	FBlueprintToDocBinaryString String;
+	String.Offset = StringData.Num();
+	String.Length = ValueUTF8.Length();
+	StringData.Append(ValueUTF8.Get(), ValueUTF8.Length());
+	StringData.Add('\0');
+
+	const uint32 Index = StringTable.Add(String);
+	StringIndices.Add(Value, Index);
+	return Index;
+}
+
+uint32 FBlueprintToDocBinaryWriter::AddString(FName Value)
+{
+	if(const uint32* Index = NameIndices.Find(Value))
+	{
+		return *Index;
+	}
+	const uint32 Index = AddString(UBlueprintToDocUtil::NameToString(Value));
+	NameIndices.Add(Value, Index);
+	return Index;
+}
+
+void FBlueprintToDocBinaryWriter::AddGraphs(const TArray<FEdGraphDocument>& EdGraphs, BlueprintToDocBinary::EGraphKind Kind)
+{
+	for(const FEdGraphDocument& EdGraph : EdGraphs)
+	{
+		FBlueprintToDocBinaryGraph Graph = {};
+		Graph.Name = AddString(EdGraph.Name);
+		Graph.Parent = AddString(EdGraph.Parent);
+		Graph.Category = AddString(EdGraph.Category);
+		Graph.ToolTips = AddString(EdGraph.ToolTips);
+		Graph.Flag = EdGraph.Flag;
+		Graph.Kind = (uint32)Kind;
+		Graph.NodeCount = EdGraph.NodeCount;
+		Graph.HotNodeCount = EdGraph.HotNodeCount;
+
+		// 入力ピンの後に出力ピンを並べる
+		Graph.FirstPin = Pins.Num();
+		for(const FEdGraphPinArray* PinArray : { &EdGraph.Input, &EdGraph.Output })
+		{
+			for(const FEdGraphPinDocument& PinDocument : *PinArray)
+			{
+				FBlueprintToDocBinaryPin Pin;
+				Pin.Name = AddString(PinDocument.Name);
+				Pin.Type = AddString(PinDocument.Type);
+				Pin.DefaultValue = AddString(PinDocument.DefaultValue);
+				Pin.ToolTips = AddString(PinDocument.ToolTips);
+				Pins.Add(Pin);
+			}
+		}
+		Graph.InputCount = EdGraph.Input.Num();
+		Graph.OutputCount = EdGraph.Output.Num();
+
+		Graphs.Add(Graph);
+	}
+}
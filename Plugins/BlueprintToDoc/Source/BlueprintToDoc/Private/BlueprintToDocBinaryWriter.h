@@ -0,0 +1,37 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BlueprintToDocBinary.h"
+
+struct FDocument;
+struct FEdGraphDocument;
+
+/**
+ * ドキュメント情報をバイナリ形式で出力する
+ */
+class FBlueprintToDocBinaryWriter
+{
+public:
+	// ドキュメントをバイナリ形式で出力
+	static bool Export(const FDocument& Document, const FString& Path);
+
+private:
+	// 文字列をテーブルに登録してインデックスを返す
+	uint32 AddString(const FString& Value);
+	// FNameは文字列にする前にインデックスで引く
+	uint32 AddString(FName Value);
+	// グラフとピンを追加
+	void AddGraphs(const TArray<FEdGraphDocument>& EdGraphs, BlueprintToDocBinary::EGraphKind Kind);
+
+	TArray<FBlueprintToDocBinaryBlueprint> Blueprints;
+	TArray<FBlueprintToDocBinaryGraph> Graphs;
+	TArray<FBlueprintToDocBinaryPin> Pins;
+	TArray<FBlueprintToDocBinaryProperty> Properties;
+
+	TArray<FBlueprintToDocBinaryString> StringTable;
+	TArray<ANSICHAR> StringData;
+	TMap<FString, uint32> StringIndices;
+	TMap<FName, uint32> NameIndices;
+};
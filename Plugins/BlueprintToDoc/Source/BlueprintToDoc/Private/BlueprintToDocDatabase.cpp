@@ -0,0 +1,240 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "BlueprintToDocDatabase.h"
+#include "BlueprintToDoc.h"
+#include "BlueprintToDocUtil.h"
+
+#include "HAL/FileManager.h"
+
+#if WITH_BLUEPRINTTODOC_SQLITE
+#include "SQLiteDatabase.h"
+#endif
+
+
+#if WITH_BLUEPRINTTODOC_SQLITE
+
+namespace BlueprintToDocDatabase
+{
+	// テーブル
+	static const TCHAR* CreateTableStatements[] =
+	{
+		TEXT("CREATE TABLE blueprints(id INTEGER PRIMARY KEY, name TEXT NOT NULL, content_path TEXT NOT NULL, parent TEXT, tooltip TEXT, hard_reference_count INTEGER, hard_reference_disk_size INTEGER, hard_reference_memory_size INTEGER, replicated_size INTEGER, instance_size INTEGER);"),
+		TEXT("CREATE TABLE graphs(id INTEGER PRIMARY KEY, blueprint_id INTEGER NOT NULL REFERENCES blueprints(id), kind TEXT NOT NULL, name TEXT NOT NULL, category TEXT, flags INTEGER, tooltip TEXT, node_count INTEGER, hot_node_count INTEGER);"),
+		TEXT("CREATE TABLE pins(id INTEGER PRIMARY KEY, graph_id INTEGER NOT NULL REFERENCES graphs(id), direction TEXT NOT NULL, name TEXT NOT NULL, type TEXT, default_value TEXT, tooltip TEXT);"),
+		TEXT("CREATE TABLE properties(id INTEGER PRIMARY KEY, blueprint_id INTEGER NOT NULL REFERENCES blueprints(id), name TEXT NOT NULL, type TEXT, category TEXT, flags INTEGER, lifetime_condition INTEGER, default_value TEXT, tooltip TEXT, size INTEGER, replicated_size INTEGER);"),
+		TEXT("CREATE TABLE type_references(blueprint_id INTEGER NOT NULL REFERENCES blueprints(id), source_kind TEXT NOT NULL, source_id INTEGER NOT NULL, target_path TEXT NOT NULL);"),
+	};
+
+	// インデックス(データを入れた後に作る)
+	static const TCHAR* CreateIndexStatements[] =
+	{
+		TEXT("CREATE INDEX blueprints_name ON blueprints(name);"),
+		TEXT("CREATE INDEX blueprints_content_path ON blueprints(content_path);"),
+		TEXT("CREATE INDEX blueprints_parent ON blueprints(parent);"),
+		TEXT("CREATE INDEX graphs_blueprint_id ON graphs(blueprint_id);"),
+		TEXT("CREATE INDEX graphs_name ON graphs(name);"),
+		TEXT("CREATE INDEX graphs_flags ON graphs(flags);"),
+		TEXT("CREATE INDEX pins_graph_id ON pins(graph_id);"),
+		TEXT("CREATE INDEX pins_type ON pins(type);"),
+		TEXT("CREATE INDEX properties_blueprint_id ON properties(blueprint_id);"),
+		TEXT("CREATE INDEX properties_name ON properties(name);"),
+		TEXT("CREATE INDEX properties_type ON properties(type);"),
+		TEXT("CREATE INDEX properties_category ON properties(category);"),
+		TEXT("CREATE INDEX type_references_target_path ON type_references(target_path);"),
+		TEXT("CREATE INDEX type_references_blueprint_id ON type_references(blueprint_id);"),
+	};
+
+	static bool Execute(FSQLiteDatabase& Database, const TCHAR* Statement)
+	{
+		if(!Database.Execute(Statement))
+		{
+			UE_LOG(LogBlueprintToDoc, Error, TEXT("Failed SQLite:%s %s"), Statement, *Database.GetLastError());
+			return false;
+		}
+		return true;
+	}
+
+	// プリペアドステートメントを実行してバインドをリセット
+	static bool Step(FSQLiteDatabase& Database, FSQLitePreparedStatement& Statement)
+	{
+		const bool bResult = Statement.Execute();
+		if(!bResult)
+		{
+			UE_LOG(LogBlueprintToDoc, Error, TEXT("Failed SQLite:%s"), *Database.GetLastError());
+		}
+		Statement.Reset();
+		Statement.ClearBindings();
+		return bResult;
+	}
+
+	// 直前に追加した行から型への参照を追加(構造体、enum、クラス以外は追加しない)
+	static bool InsertTypeReference(FSQLiteDatabase& Database, FSQLitePreparedStatement& ReferenceStatement, int64 BlueprintId, const TCHAR* SourceKind, FName TypePath)
+	{
+		if(TypePath.IsNone())
+		{
+			return true;
+		}
+		ReferenceStatement.SetBindingValueByIndex(1, BlueprintId);
+		ReferenceStatement.SetBindingValueByIndex(2, FString(SourceKind));
+		ReferenceStatement.SetBindingValueByIndex(3, Database.GetLastInsertRowId());
+		ReferenceStatement.SetBindingValueByIndex(4, TypePath.ToString());
+		return Step(Database, ReferenceStatement);
+	}
+
+	// グラフとピンを追加
+	static bool InsertGraphs(FSQLiteDatabase& Database, FSQLitePreparedStatement& GraphStatement, FSQLitePreparedStatement& PinStatement, FSQLitePreparedStatement& ReferenceStatement, int64 BlueprintId, const TCHAR* Kind, const TArray<FEdGraphDocument>& EdGraphs)
+	{
+		for(const FEdGraphDocument& EdGraph : EdGraphs)
+		{
+			GraphStatement.SetBindingValueByIndex(1, BlueprintId);
+			GraphStatement.SetBindingValueByIndex(2, FString(Kind));
+			GraphStatement.SetBindingValueByIndex(3, EdGraph.Name);
+			GraphStatement.SetBindingValueByIndex(4, UBlueprintToDocUtil::NameToString(EdGraph.Category));
+			GraphStatement.SetBindingValueByIndex(5, (int64)EdGraph.Flag);
+			GraphStatement.SetBindingValueByIndex(6, EdGraph.ToolTips);
+			GraphStatement.SetBindingValueByIndex(7, EdGraph.NodeCount);
+			GraphStatement.SetBindingValueByIndex(8, EdGraph.HotNodeCount);
+			if(!Step(Database, GraphStatement))
+			{
+				return false;
+			}
+			const int64 GraphId = Database.GetLastInsertRowId();
+
+			const TPair<const FEdGraphPinArray*, const TCHAR*> PinGroups[] =
+			{
+				{ &EdGraph.Input, TEXT("in") },
+				{ &EdGraph.Output, TEXT("out") },
+			};
+			for(const auto& PinGroup : PinGroups)
+			{
+				for(const FEdGraphPinDocument& Pin : *PinGroup.Key)
+				{
+					PinStatement.SetBindingValueByIndex(1, GraphId);
+					PinStatement.SetBindingValueByIndex(2, FString(PinGroup.Value));
+					PinStatement.SetBindingValueByIndex(3, Pin.Name);
+					PinStatement.SetBindingValueByIndex(4, UBlueprintToDocUtil::NameToString(Pin.Type));
+					PinStatement.SetBindingValueByIndex(5, Pin.DefaultValue);
+					PinStatement.SetBindingValueByIndex(6, Pin.ToolTips);
+					if(!Step(Database, PinStatement) || !InsertTypeReference(Database, ReferenceStatement, BlueprintId, TEXT("pin"), Pin.TypePath))
+					{
+						return false;
+					}
+				}
+			}
+		}
+		return true;
+	}
+
+	static bool InsertDocument(FSQLiteDatabase& Database, const FDocument& Document)
+	{
+		FSQLitePreparedStatement BlueprintStatement = Database.PrepareStatement(TEXT("INSERT INTO blueprints(name, content_path, parent, tooltip, hard_reference_count, hard_reference_disk_size, hard_reference_memory_size, replicated_size, instance_size) VALUES(?, ?, ?, ?, ?, ?, ?, ?, ?);"), ESQLitePreparedStatementFlags::Persistent);
+		FSQLitePreparedStatement GraphStatement = Database.PrepareStatement(TEXT("INSERT INTO graphs(blueprint_id, kind, name, category, flags, tooltip, node_count, hot_node_count) VALUES(?, ?, ?, ?, ?, ?, ?, ?);"), ESQLitePreparedStatementFlags::Persistent);
+		FSQLitePreparedStatement PinStatement = Database.PrepareStatement(TEXT("INSERT INTO pins(graph_id, direction, name, type, default_value, tooltip) VALUES(?, ?, ?, ?, ?, ?);"), ESQLitePreparedStatementFlags::Persistent);
+		FSQLitePreparedStatement PropertyStatement = Database.PrepareStatement(TEXT("INSERT INTO properties(blueprint_id, name, type, category, flags, lifetime_condition, default_value, tooltip, size, replicated_size) VALUES(?, ?, ?, ?, ?, ?, ?, ?, ?, ?);"), ESQLitePreparedStatementFlags::Persistent);
+		FSQLitePreparedStatement ReferenceStatement = Database.PrepareStatement(TEXT("INSERT INTO type_references(blueprint_id, source_kind, source_id, target_path) VALUES(?, ?, ?, ?);"), ESQLitePreparedStatementFlags::Persistent);
+		if(!BlueprintStatement.IsValid() || !GraphStatement.IsValid() || !PinStatement.IsValid() || !PropertyStatement.IsValid() || !ReferenceStatement.IsValid())
+		{
+			UE_LOG(LogBlueprintToDoc, Error, TEXT("Failed SQLite:%s"), *Database.GetLastError());
+			return false;
+		}
+
+		for(const FBlueprintDocument& BlueprintDocument : Document.Blueprints)
+		{
+			BlueprintStatement.SetBindingValueByIndex(1, BlueprintDocument.Name);
+			BlueprintStatement.SetBindingValueByIndex(2, BlueprintDocument.ContentPath);
+			BlueprintStatement.SetBindingValueByIndex(3, BlueprintDocument.ParentName);
+			BlueprintStatement.SetBindingValueByIndex(4, BlueprintDocument.ToolTips);
+			BlueprintStatement.SetBindingValueByIndex(5, BlueprintDocument.HardReferenceCount);
+			BlueprintStatement.SetBindingValueByIndex(6, BlueprintDocument.HardReferenceDiskSize);
+			BlueprintStatement.SetBindingValueByIndex(7, BlueprintDocument.HardReferenceMemorySize);
+			BlueprintStatement.SetBindingValueByIndex(8, BlueprintDocument.ReplicatedSize);
+			BlueprintStatement.SetBindingValueByIndex(9, BlueprintDocument.InstanceSize);
+			if(!Step(Database, BlueprintStatement))
+			{
+				return false;
+			}
+			const int64 BlueprintId = Database.GetLastInsertRowId();
+
+			if(!InsertGraphs(Database, GraphStatement, PinStatement, ReferenceStatement, BlueprintId, TEXT("event"), BlueprintDocument.Events)
+				|| !InsertGraphs(Database, GraphStatement, PinStatement, ReferenceStatement, BlueprintId, TEXT("macro"), BlueprintDocument.Macros)
+				|| !InsertGraphs(Database, GraphStatement, PinStatement, ReferenceStatement, BlueprintId, TEXT("function"), BlueprintDocument.Functions))
+			{
+				return false;
+			}
+
+			for(const FPropertyDocument& PropertyDocument : BlueprintDocument.Properties)
+			{
+				PropertyStatement.SetBindingValueByIndex(1, BlueprintId);
+				PropertyStatement.SetBindingValueByIndex(2, PropertyDocument.Name);
+				PropertyStatement.SetBindingValueByIndex(3, UBlueprintToDocUtil::NameToString(PropertyDocument.Type));
+				PropertyStatement.SetBindingValueByIndex(4, UBlueprintToDocUtil::NameToString(PropertyDocument.Category));
+				PropertyStatement.SetBindingValueByIndex(5, PropertyDocument.PropertyFlg);
+				PropertyStatement.SetBindingValueByIndex(6, (int32)PropertyDocument.LifetimeCondition);
+				PropertyStatement.SetBindingValueByIndex(7, PropertyDocument.DefaultValue);
+				PropertyStatement.SetBindingValueByIndex(8, PropertyDocument.ToolTips);
+				PropertyStatement.SetBindingValueByIndex(9, PropertyDocument.Size);
+				PropertyStatement.SetBindingValueByIndex(10, PropertyDocument.ReplicatedSize);
+				if(!Step(Database, PropertyStatement) || !InsertTypeReference(Database, ReferenceStatement, BlueprintId, TEXT("property"), PropertyDocument.TypePath))
+				{
+					return false;
+				}
+			}
+		}
+		return true;
+	}
+}
+
+bool FBlueprintToDocDatabase::Export(const FDocument& Document, const FString& Path)
+{
+	using namespace BlueprintToDocDatabase;
+
+	// 毎回作り直す
+	IFileManager::Get().Delete(*Path, false, true, true);
+	IFileManager::Get().MakeDirectory(*FPaths::GetPath(Path), true);
+
+	FSQLiteDatabase Database;
+	if(!Database.Open(*Path, ESQLiteDatabaseOpenMode::ReadWriteCreate))
+	{
+		UE_LOG(LogBlueprintToDoc, Error, TEXT("Failed Open Database:%s"), *Path);
+		return false;
+	}
+
+	// 作り直すのでジャーナルは不要
+	bool bResult = Execute(Database, TEXT("PRAGMA journal_mode=OFF;"))
+		&& Execute(Database, TEXT("PRAGMA synchronous=OFF;"));
+
+	for(const TCHAR* Statement : CreateTableStatements)
+	{
+		bResult = bResult && Execute(Database, Statement);
+	}
+
+	// 一つのトランザクションでまとめて追加
+	if(bResult && Execute(Database, TEXT("BEGIN TRANSACTION;")))
+	{
+		bResult = InsertDocument(Database, Document);
+		bResult = Execute(Database, bResult ? TEXT("COMMIT;") : TEXT("ROLLBACK;")) && bResult;
+	}
+	else
+	{
+		bResult = false;
+	}
+
+	for(const TCHAR* Statement : CreateIndexStatements)
+	{
+		bResult = bResult && Execute(Database, Statement);
+	}
+	bResult = bResult && Execute(Database, TEXT("ANALYZE;"));
+
+	Database.Close();
+	return bResult;
+}
+
+#else
+
+bool FBlueprintToDocDatabase::Export(const FDocument& Document, const FString& Path)
+{
+	UE_LOG(LogBlueprintToDoc, Warning, TEXT("SQLiteCore plugin is not available. Skip Database:%s"), *Path);
+	return false;
+}
+
+#endif
@@ -0,0 +1,18 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FDocument;
+
+/**
+ * ドキュメント情報をSQLiteのデータベースに出力する
+ * SQLiteCoreプラグインが無い環境では出力しない
+ */
+class FBlueprintToDocDatabase
+{
+public:
+	// データベースを作り直して出力
+	static bool Export(const FDocument& Document, const FString& Path);
+};
@@ -0,0 +1,271 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "BlueprintToDocFlagLabels.h"
+#include "BlueprintToDocHTMLWriter.h"
+
+#include "Misc/ScopeRWLock.h"
+#include "UObject/Script.h"
+#include "UObject/ObjectMacros.h"
+
+
+namespace
+{
+	// フラグと表示名
+	struct FFlagLabel
+	{
+		uint64 Flag;
+		const ANSICHAR* Label;
+	};
+
+	// 関数
+	const FFlagLabel FunctionAccessLabels[] =
+	{
+		{ FUNC_Public,                 "Public" },
+		{ FUNC_Private,                "Private" },
+		{ FUNC_Protected,              "Protected" },
+	};
+	const FFlagLabel FunctionNetLabels[] =
+	{
+		{ FUNC_Net,                    "Net" },
+		{ FUNC_NetResponse,            "NetResponse" },
+		{ FUNC_NetServer,              "NetServer" },
+		{ FUNC_NetMulticast,           "NetMulticast" },
+		{ FUNC_NetRequest,             "NetRequest" },
+		{ FUNC_NetClient,              "NetClient" },
+		{ FUNC_NetReliable,            "NetReliable" },
+	};
+	const FFlagLabel FunctionFlagLabels[] =
+	{
+		{ FUNC_Final,                  "Final" },
+		{ FUNC_RequiredAPI,            "RequiredAPI" },
+		{ FUNC_BlueprintAuthorityOnly, "BlueprintAuthorityOnly" },
+		{ FUNC_BlueprintCosmetic,      "BlueprintCosmetic" },
+		{ FUNC_Exec,                   "Exec" },
+		{ FUNC_Native,                 "Native" },
+		{ FUNC_Event,                  "Event" },
+		{ FUNC_Static,                 "Static" },
+		{ FUNC_UbergraphFunction,      "UbergraphFunction" },
+		{ FUNC_MulticastDelegate,      "MulticastDelegate" },
+		{ FUNC_BlueprintCallable,      "BlueprintCallable" },
+		{ FUNC_BlueprintEvent,         "BlueprintEvent" },
+		{ FUNC_BlueprintPure,          "BlueprintPure" },
+		{ FUNC_EditorOnly,             "EditorOnly" },
+		{ FUNC_Const,                  "Const" },
+		{ FUNC_NetValidate,            "NetValidate" },
+		{ FUNC_Delegate,               "Delegate" },
+		{ FUNC_HasOutParms,            "HasOutParms" },
+		{ FUNC_HasDefaults,            "HasDefaults" },
+		{ FUNC_DLLImport,              "DLLImport" },
+	};
+
+	// プロパティ
+	const FFlagLabel PropertyAccessLabels[] =
+	{
+		{ CPF_Protected,                  "Protected" },
+	};
+	const FFlagLabel PropertyNetLabels[] =
+	{
+		{ CPF_Net,                        "Net" },
+		{ CPF_RepSkip,                    "RepSkip" },
+		{ CPF_RepNotify,                  "RepNotify" },
+	};
+	const FFlagLabel PropertyFlagLabels[] =
+	{
+		{ CPF_Edit,                       "Edit" },
+		{ CPF_ConstParm,                  "ConstParm" },
+		{ CPF_BlueprintVisible,           "BlueprintVisible" },
+		{ CPF_ExportObject,               "ExportObject" },
+		{ CPF_BlueprintReadOnly,          "BlueprintReadOnly" },
+		{ CPF_EditFixedSize,              "EditFixedSize" },
+		{ CPF_Parm,                       "Parm" },
+		{ CPF_OutParm,                    "OutParm" },
+		{ CPF_ZeroConstructor,            "ZeroConstructor" },
+		{ CPF_ReturnParm,                 "ReturnParm" },
+		{ CPF_DisableEditOnTemplate,      "DisableEditOnTemplate" },
+		{ CPF_Transient,                  "Transient" },
+		{ CPF_Config,                     "Config" },
+		{ CPF_DisableEditOnInstance,      "DisableEditOnInstance" },
+		{ CPF_EditConst,                  "EditConst" },
+		{ CPF_GlobalConfig,               "GlobalConfig" },
+		{ CPF_InstancedReference,         "InstancedReference" },
+		{ CPF_DuplicateTransient,         "DuplicateTransient" },
+		{ CPF_SubobjectReference,         "SubobjectReference" },
+		{ CPF_SaveGame,                   "SaveGame" },
+		{ CPF_NoClear,                    "NoClear" },
+		{ CPF_ReferenceParm,              "ReferenceParm" },
+		{ CPF_BlueprintAssignable,        "BlueprintAssignable" },
+		{ CPF_Deprecated,                 "Deprecated" },
+		{ CPF_IsPlainOldData,             "IsPlainOldData" },
+		{ CPF_ExposeOnSpawn,              "ExposeOnSpawn" },
+		{ CPF_EditorOnly,                 "EditorOnly" },
+		{ CPF_Interp,                     "Interp" },
+		{ CPF_NonTransactional,           "NonTransactional" },
+		{ CPF_NoDestructor,               "NoDestructor" },
+		{ CPF_AutoWeak,                   "AutoWeak" },
+		{ CPF_ContainsInstancedReference, "ContainsInstancedReference" },
+		{ CPF_AssetRegistrySearchable,    "AssetRegistrySearchable" },
+		{ CPF_SimpleDisplay,              "SimpleDisplay" },
+		{ CPF_AdvancedDisplay,            "AdvancedDisplay" },
+		{ CPF_BlueprintCallable,          "BlueprintCallable" },
+		{ CPF_BlueprintAuthorityOnly,     "BlueprintAuthorityOnly" },
+		{ CPF_TextExportTransient,        "TextExportTransient" },
+		{ CPF_NonPIEDuplicateTransient,   "NonPIEDuplicateTransient" },
+		{ CPF_PersistentInstance,         "PersistentInstance" },
+		{ CPF_UObjectWrapper,             "UObjectWrapper" },
+		{ CPF_HasGetValueTypeHash,        "HasGetValueTypeHash" },
+	};
+
+	// ELifetimeConditionの順
+	const ANSICHAR* const LifetimeConditionLabels[] =
+	{
+		"None",
+		"Initial Only",
+		"Owner Only",
+		"Skip Owner",
+		"Simulated Only",
+		"Autonomous Only",
+		"Simulated Or Physics",
+		"Initial Or Owner",
+		"Custom",
+		"Replay Or Owner",
+		"Replay Only",
+		"Simulated Only No Replay",
+		"Simulated Or Physics No Replay",
+		"Skip Replay",
+	};
+	static_assert(ARRAY_COUNT(LifetimeConditionLabels) == COND_Max, "LifetimeConditionLabels is out of sync with ELifetimeCondition");
+
+	// 列ごとの表
+	struct FColumnTable
+	{
+		const FFlagLabel* Labels;
+		int32 Num;
+	};
+
+	template<int32 N>
+	constexpr FColumnTable MakeColumnTable(const FFlagLabel (&Labels)[N])
+	{
+		return { Labels, N };
+	}
+
+	const FColumnTable ColumnTables[] =
+	{
+		MakeColumnTable(FunctionAccessLabels),
+		MakeColumnTable(FunctionNetLabels),
+		MakeColumnTable(FunctionFlagLabels),
+		MakeColumnTable(PropertyAccessLabels),
+		MakeColumnTable(PropertyNetLabels),
+		MakeColumnTable(PropertyFlagLabels),
+	};
+	static_assert(ARRAY_COUNT(ColumnTables) == (int32)FBlueprintToDocFlagLabels::EColumn::Num, "ColumnTables is out of sync with EColumn");
+
+	// 表に含まれるフラグ(キャッシュのキーから無関係なビットを除く)
+	uint64 GetColumnMask(FBlueprintToDocFlagLabels::EColumn Column)
+	{
+		struct FMasks
+		{
+			uint64 Masks[(int32)FBlueprintToDocFlagLabels::EColumn::Num];
+
+			FMasks()
+			{
+				for(int32 Index = 0; Index < ARRAY_COUNT(ColumnTables); ++Index)
+				{
+					Masks[Index] = 0;
+					for(int32 LabelIndex = 0; LabelIndex < ColumnTables[Index].Num; ++LabelIndex)
+					{
+						Masks[Index] |= ColumnTables[Index].Labels[LabelIndex].Flag;
+					}
+				}
+			}
+		};
+		static const FMasks Masks;
+		return Masks.Masks[(int32)Column];
+	}
+
+	// 描画済みの列(ビットマスクごと)
+	// 描画中のアリーナより長く残るので、ヒープに確保したバイト列で持つ
+	struct FFragmentCache
+	{
+		FRWLock Lock;
+		TMap<uint64, TArray<uint8>> Fragments[(int32)FBlueprintToDocFlagLabels::EColumn::Num];
+	};
+
+	FFragmentCache& GetFragmentCache()
+	{
+		static FFragmentCache Cache;
+		return Cache;
+	}
+
+	// キャッシュにあれば追加してtrueを返す
+	bool AppendCachedFragment(FBlueprintToDocHTMLWriter& OutHTML, FBlueprintToDocFlagLabels::EColumn Column, uint64 Key)
+	{
+		FFragmentCache& Cache = GetFragmentCache();
+		FReadScopeLock Lock(Cache.Lock);
+		if(const TArray<uint8>* Fragment = Cache.Fragments[(int32)Column].Find(Key))
+		{
+			OutHTML.AppendUTF8((const ANSICHAR*)Fragment->GetData(), Fragment->Num());
+			return true;
+		}
+		return false;
+	}
+
+	// 描画した列を追加してキャッシュする
+	void AddFragment(FBlueprintToDocHTMLWriter& OutHTML, FBlueprintToDocFlagLabels::EColumn Column, uint64 Key, const FBlueprintToDocHTMLWriter& Fragment)
+	{
+		OutHTML.Append(Fragment);
+
+		FFragmentCache& Cache = GetFragmentCache();
+		FWriteScopeLock Lock(Cache.Lock);
+		Cache.Fragments[(int32)Column].Add(Key, TArray<uint8>(Fragment.GetBytes()));
+	}
+
+	// 立っているフラグを1行ずつ描画
+	void RenderFlags(FBlueprintToDocHTMLWriter& OutHTML, FBlueprintToDocFlagLabels::EColumn Column, uint64 Flags)
+	{
+		const FColumnTable& Table = ColumnTables[(int32)Column];
+		for(int32 Index = 0; Index < Table.Num; ++Index)
+		{
+			if((Flags & Table.Labels[Index].Flag) != 0)
+			{
+				OutHTML.AppendUTF8(Table.Labels[Index].Label, FCStringAnsi::Strlen(Table.Labels[Index].Label));
+				OutHTML.Append("</br>\n");
+			}
+		}
+	}
+}
+
+
+void FBlueprintToDocFlagLabels::AppendFragment(FBlueprintToDocHTMLWriter& OutHTML, EColumn Column, uint64 Flags)
+{
+	const uint64 Key = Flags & GetColumnMask(Column);
+	if(Key == 0 || AppendCachedFragment(OutHTML, Column, Key))
+	{
+		return;
+	}
+
+	FBlueprintToDocHTMLWriter Fragment;
+	RenderFlags(Fragment, Column, Key);
+	AddFragment(OutHTML, Column, Key, Fragment);
+}
+
+void FBlueprintToDocFlagLabels::AppendPropertyNetFragment(FBlueprintToDocHTMLWriter& OutHTML, uint64 Flags, ELifetimeCondition Condition)
+{
+	// Netのフラグは下位のビットなので、上位のビットにLifetimeを入れる
+	const uint64 Key = (Flags & GetColumnMask(EColumn::PropertyNet)) | ((uint64)Condition << 56);
+	if(AppendCachedFragment(OutHTML, EColumn::PropertyNet, Key))
+	{
+		return;
+	}
+
+	FBlueprintToDocHTMLWriter Fragment;
+	RenderFlags(Fragment, EColumn::PropertyNet, Flags);
+	const ANSICHAR* Label = GetLifetimeConditionLabel(Condition);
+	Fragment.AppendUTF8(Label, FCStringAnsi::Strlen(Label));
+	Fragment.Append("</br>\n");
+	AddFragment(OutHTML, EColumn::PropertyNet, Key, Fragment);
+}
+
+const ANSICHAR* FBlueprintToDocFlagLabels::GetLifetimeConditionLabel(ELifetimeCondition Condition)
+{
+	return ((int32)Condition >= 0 && (int32)Condition < ARRAY_COUNT(LifetimeConditionLabels)) ? LifetimeConditionLabels[Condition] : "";
+}
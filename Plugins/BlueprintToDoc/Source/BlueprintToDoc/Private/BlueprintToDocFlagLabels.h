@@ -0,0 +1,35 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CoreNetTypes.h"
+
+class FBlueprintToDocHTMLWriter;
+
+/**
+ * フラグと表示名の対応表
+ * Access / Net / Flag の列はビットマスクごとに一度だけ描画してキャッシュする(どのスレッドからでも呼べる)
+ */
+class FBlueprintToDocFlagLabels
+{
+public:
+	// 表に出力する列
+	enum class EColumn : uint8
+	{
+		FunctionAccess,
+		FunctionNet,
+		FunctionFlag,
+		PropertyAccess,
+		PropertyNet,
+		PropertyFlag,
+		Num,
+	};
+
+	// 立っているフラグを1行ずつ追加
+	static void AppendFragment(FBlueprintToDocHTMLWriter& OutHTML, EColumn Column, uint64 Flags);
+	// プロパティのNet列(フラグとLifetime)を追加
+	static void AppendPropertyNetFragment(FBlueprintToDocHTMLWriter& OutHTML, uint64 Flags, ELifetimeCondition Condition);
+	// ELifetimeConditionの表示名
+	static const ANSICHAR* GetLifetimeConditionLabel(ELifetimeCondition Condition);
+};
@@ -0,0 +1,310 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "BlueprintToDocGraphSVG.h"
+#include "BlueprintToDocHTMLWriter.h"
+#include "BlueprintToDocUtil.h"
+
+#include "EdGraphSchema_K2.h"
+
+
+namespace
+{
+	// ノードの寸法(エディタの見た目に近い値)
+	const int32 HeaderHeight = 24;
+	const int32 PinHeight = 20;
+	const int32 PinLabelOffset = 14;
+	const int32 MinNodeWidth = 80;
+	const int32 GraphMargin = 32;
+
+	// 全てのグラフで共通のスタイルとピンの記号
+	const ANSICHAR SVGDefinitions[] =
+		"<style>"
+		".bg{fill:#262626}"
+		".n{fill:#141414;fill-opacity:.9;stroke:#000}"
+		".h{fill:#2c4662}"
+		".cm{fill:#fff;fill-opacity:.06;stroke:#999}"
+		"text{fill:#ddd;font:11px sans-serif}"
+		".t{font-weight:bold;fill:#fff}"
+		".r{text-anchor:end}"
+		".x{fill:#fff;stroke:#fff}"
+		".b{fill:#950000;stroke:#950000}"
+		".y{fill:#006f65;stroke:#006f65}"
+		".i{fill:#1fe3af;stroke:#1fe3af}"
+		".f{fill:#9ff44c;stroke:#9ff44c}"
+		".nm{fill:#c883ff;stroke:#c883ff}"
+		".s{fill:#f300d1;stroke:#f300d1}"
+		".tx{fill:#e17c9c;stroke:#e17c9c}"
+		".st{fill:#0059cb;stroke:#0059cb}"
+		".o{fill:#00a9f4;stroke:#00a9f4}"
+		".d{fill:#aaa;stroke:#aaa}"
+		"path.w{fill:none;stroke-width:2;stroke-opacity:.8}"
+		"</style>"
+		"<defs>"
+		"<symbol id=\"pe\" overflow=\"visible\"><path d=\"M-4 -5h5l4 5-4 5h-5z\"/></symbol>"
+		"<symbol id=\"pd\" overflow=\"visible\"><circle r=\"4\"/></symbol>"
+		"</defs>\n";
+
+	// ピンのカテゴリと色のクラス
+	struct FPinStyle
+	{
+		const FName* Category;
+		const ANSICHAR* Class;
+	};
+	const FPinStyle PinStyles[] =
+	{
+		{ &UEdGraphSchema_K2::PC_Exec,      "x" },
+		{ &UEdGraphSchema_K2::PC_Boolean,   "b" },
+		{ &UEdGraphSchema_K2::PC_Byte,      "y" },
+		{ &UEdGraphSchema_K2::PC_Int,       "i" },
+		{ &UEdGraphSchema_K2::PC_Float,     "f" },
+		{ &UEdGraphSchema_K2::PC_Name,      "nm" },
+		{ &UEdGraphSchema_K2::PC_String,    "s" },
+		{ &UEdGraphSchema_K2::PC_Text,      "tx" },
+		{ &UEdGraphSchema_K2::PC_Struct,    "st" },
+		{ &UEdGraphSchema_K2::PC_Object,    "o" },
+		{ &UEdGraphSchema_K2::PC_Class,     "o" },
+		{ &UEdGraphSchema_K2::PC_Interface, "o" },
+	};
+
+	const ANSICHAR* GetPinClass(FName Category)
+	{
+		for(const FPinStyle& PinStyle : PinStyles)
+		{
+			if(*PinStyle.Category == Category)
+			{
+				return PinStyle.Class;
+			}
+		}
+		return "d";
+	}
+
+	// 文字列の表示幅の見積もり(ASCII以外は全角とみなす)
+	int32 EstimateTextWidth(const FString& Text)
+	{
+		int32 Width = 0;
+		for(int32 Index = 0; Index < Text.Len(); ++Index)
+		{
+			Width += (Text[Index] < 0x80) ? 7 : 12;
+		}
+		return Width;
+	}
+
+	void AppendClass(FBlueprintToDocHTMLWriter& OutHTML, const ANSICHAR* Class)
+	{
+		OutHTML.AppendUTF8(Class, FCStringAnsi::Strlen(Class));
+	}
+
+	// ピンの中心(ノードの左上から)
+	FIntPoint GetPinOffset(const FIntPoint& NodeSize, bool bOutput, int32 PinIndex)
+	{
+		return FIntPoint(bOutput ? NodeSize.X - 8 : 8, HeaderHeight + PinIndex * PinHeight + PinHeight / 2);
+	}
+
+	void AppendPin(FBlueprintToDocHTMLWriter& OutHTML, const FEdGraphPinLayout& PinLayout, const FIntPoint& NodeSize, bool bOutput, int32 PinIndex)
+	{
+		const FIntPoint Offset = GetPinOffset(NodeSize, bOutput, PinIndex);
+		const bool bExec = (PinLayout.Category == UEdGraphSchema_K2::PC_Exec);
+
+		if(bExec)
+		{
+			OutHTML.Append("<use href=\"#pe\" class=\"");
+		}
+		else
+		{
+			OutHTML.Append("<use href=\"#pd\" class=\"");
+		}
+		AppendClass(OutHTML, GetPinClass(PinLayout.Category));
+		OutHTML.Append("\" x=\"");
+		OutHTML.AppendInt(Offset.X);
+		OutHTML.Append("\" y=\"");
+		OutHTML.AppendInt(Offset.Y);
+		OutHTML.Append("\"/>");
+
+		if(!PinLayout.Name.IsEmpty())
+		{
+			if(bOutput)
+			{
+				OutHTML.Append("<text class=\"r\" x=\"");
+				OutHTML.AppendInt(Offset.X - PinLabelOffset);
+			}
+			else
+			{
+				OutHTML.Append("<text x=\"");
+				OutHTML.AppendInt(Offset.X + PinLabelOffset);
+			}
+
+			OutHTML.Append("\" y=\"");
+			OutHTML.AppendInt(Offset.Y + 4);
+			OutHTML.Append("\">");
+			OutHTML.AppendEscaped(PinLayout.Name);
+			OutHTML.Append("</text>");
+		}
+	}
+}
+
+
+FIntPoint FBlueprintToDocGraphSVG::GetNodeSize(const FEdGraphNodeLayout& NodeLayout)
+{
+	if(NodeLayout.Width > 0 && NodeLayout.Height > 0)
+	{
+		return FIntPoint(NodeLayout.Width, NodeLayout.Height);
+	}
+
+	int32 InputWidth = 0;
+	for(const FEdGraphPinLayout& PinLayout : NodeLayout.Inputs)
+	{
+		InputWidth = FMath::Max(InputWidth, EstimateTextWidth(PinLayout.Name));
+	}
+	int32 OutputWidth = 0;
+	for(const FEdGraphPinLayout& PinLayout : NodeLayout.Outputs)
+	{
+		OutputWidth = FMath::Max(OutputWidth, EstimateTextWidth(PinLayout.Name));
+	}
+
+	const int32 Width = FMath::Max3(MinNodeWidth, EstimateTextWidth(NodeLayout.Title) + 16, InputWidth + OutputWidth + (8 + PinLabelOffset) * 2 + 16);
+	const int32 Height = HeaderHeight + FMath::Max(NodeLayout.Inputs.Num(), NodeLayout.Outputs.Num()) * PinHeight + 6;
+	return FIntPoint(Width, Height);
+}
+
+void FBlueprintToDocGraphSVG::Append(FBlueprintToDocHTMLWriter& OutHTML, const FEdGraphDocument& EdGraph)
+{
+	const TArray<FEdGraphNodeLayout>& NodeLayouts = EdGraph.NodeLayouts;
+	if(NodeLayouts.Num() == 0)
+	{
+		return;
+	}
+
+	// ノードの大きさは接続の描画でも使うので先に求める
+	TArray<FIntPoint> NodeSizes;
+	NodeSizes.Reserve(NodeLayouts.Num());
+	FIntRect Bounds(NodeLayouts[0].X, NodeLayouts[0].Y, NodeLayouts[0].X, NodeLayouts[0].Y);
+	for(const FEdGraphNodeLayout& NodeLayout : NodeLayouts)
+	{
+		const FIntPoint NodeSize = GetNodeSize(NodeLayout);
+		NodeSizes.Add(NodeSize);
+		Bounds.Include(FIntPoint(NodeLayout.X, NodeLayout.Y));
+		Bounds.Include(FIntPoint(NodeLayout.X, NodeLayout.Y) + NodeSize);
+	}
+	Bounds.InflateRect(GraphMargin);
+
+	OutHTML.Append("<svg xmlns=\"http://www.w3.org/2000/svg\" style=\"max-width:100%;height:auto\" width=\"");
+	OutHTML.AppendInt(Bounds.Width());
+	OutHTML.Append("\" height=\"");
+	OutHTML.AppendInt(Bounds.Height());
+	OutHTML.Append("\" viewBox=\"");
+	OutHTML.AppendInt(Bounds.Min.X);
+	OutHTML.Append(" ");
+	OutHTML.AppendInt(Bounds.Min.Y);
+	OutHTML.Append(" ");
+	OutHTML.AppendInt(Bounds.Width());
+	OutHTML.Append(" ");
+	OutHTML.AppendInt(Bounds.Height());
+	OutHTML.Append("\">\n");
+	OutHTML.Append(SVGDefinitions);
+
+	// 背景
+	OutHTML.Append("<rect class=\"bg\" x=\"");
+	OutHTML.AppendInt(Bounds.Min.X);
+	OutHTML.Append("\" y=\"");
+	OutHTML.AppendInt(Bounds.Min.Y);
+	OutHTML.Append("\" width=\"100%\" height=\"100%\"/>\n");
+
+	// コメントボックスはノードと接続の下に描く
+	for(int32 NodeIndex = 0; NodeIndex < NodeLayouts.Num(); ++NodeIndex)
+	{
+		const FEdGraphNodeLayout& NodeLayout = NodeLayouts[NodeIndex];
+		if(!NodeLayout.bIsComment)
+		{
+			continue;
+		}
+		OutHTML.Append("<g transform=\"translate(");
+		OutHTML.AppendInt(NodeLayout.X);
+		OutHTML.Append(" ");
+		OutHTML.AppendInt(NodeLayout.Y);
+		OutHTML.Append(")\"><rect class=\"cm\" width=\"");
+		OutHTML.AppendInt(NodeSizes[NodeIndex].X);
+		OutHTML.Append("\" height=\"");
+		OutHTML.AppendInt(NodeSizes[NodeIndex].Y);
+		OutHTML.Append("\"/><text class=\"t\" x=\"6\" y=\"16\">");
+		OutHTML.AppendEscaped(NodeLayout.Title);
+		OutHTML.Append("</text></g>\n");
+	}
+
+	// 接続(出力ピンの色)
+	for(const FEdGraphWireLayout& WireLayout : EdGraph.WireLayouts)
+	{
+		if(!NodeLayouts.IsValidIndex(WireLayout.FromNode) || !NodeLayouts.IsValidIndex(WireLayout.ToNode))
+		{
+			continue;
+		}
+		const FEdGraphNodeLayout& FromNode = NodeLayouts[WireLayout.FromNode];
+		const FEdGraphNodeLayout& ToNode = NodeLayouts[WireLayout.ToNode];
+		if(!FromNode.Outputs.IsValidIndex(WireLayout.FromPin) || !ToNode.Inputs.IsValidIndex(WireLayout.ToPin))
+		{
+			continue;
+		}
+
+		const FIntPoint From = FIntPoint(FromNode.X, FromNode.Y) + GetPinOffset(NodeSizes[WireLayout.FromNode], true, WireLayout.FromPin);
+		const FIntPoint To = FIntPoint(ToNode.X, ToNode.Y) + GetPinOffset(NodeSizes[WireLayout.ToNode], false, WireLayout.ToPin);
+		const int32 Tangent = FMath::Max(FMath::Abs(To.X - From.X) / 2, 40);
+
+		OutHTML.Append("<path class=\"w ");
+		AppendClass(OutHTML, GetPinClass(FromNode.Outputs[WireLayout.FromPin].Category));
+		OutHTML.Append("\" d=\"M");
+		OutHTML.AppendInt(From.X);
+		OutHTML.Append(" ");
+		OutHTML.AppendInt(From.Y);
+		OutHTML.Append("C");
+		OutHTML.AppendInt(From.X + Tangent);
+		OutHTML.Append(" ");
+		OutHTML.AppendInt(From.Y);
+		OutHTML.Append(" ");
+		OutHTML.AppendInt(To.X - Tangent);
+		OutHTML.Append(" ");
+		OutHTML.AppendInt(To.Y);
+		OutHTML.Append(" ");
+		OutHTML.AppendInt(To.X);
+		OutHTML.Append(" ");
+		OutHTML.AppendInt(To.Y);
+		OutHTML.Append("\"/>\n");
+	}
+
+	// ノード
+	for(int32 NodeIndex = 0; NodeIndex < NodeLayouts.Num(); ++NodeIndex)
+	{
+		const FEdGraphNodeLayout& NodeLayout = NodeLayouts[NodeIndex];
+		if(NodeLayout.bIsComment)
+		{
+			continue;
+		}
+		const FIntPoint& NodeSize = NodeSizes[NodeIndex];
+
+		OutHTML.Append("<g transform=\"translate(");
+		OutHTML.AppendInt(NodeLayout.X);
+		OutHTML.Append(" ");
+		OutHTML.AppendInt(NodeLayout.Y);
+		OutHTML.Append(")\"><rect class=\"n\" rx=\"4\" width=\"");
+		OutHTML.AppendInt(NodeSize.X);
+		OutHTML.Append("\" height=\"");
+		OutHTML.AppendInt(NodeSize.Y);
+		OutHTML.Append("\"/><rect class=\"h\" rx=\"4\" width=\"");
+		OutHTML.AppendInt(NodeSize.X);
+		OutHTML.Append("\" height=\"");
+		OutHTML.AppendInt(HeaderHeight);
+		OutHTML.Append("\"/><text class=\"t\" x=\"8\" y=\"16\">");
+		OutHTML.AppendEscaped(NodeLayout.Title);
+		OutHTML.Append("</text>");
+
+		for(int32 PinIndex = 0; PinIndex < NodeLayout.Inputs.Num(); ++PinIndex)
+		{
+			AppendPin(OutHTML, NodeLayout.Inputs[PinIndex], NodeSize, false, PinIndex);
+		}
+		for(int32 PinIndex = 0; PinIndex < NodeLayout.Outputs.Num(); ++PinIndex)
+		{
+			AppendPin(OutHTML, NodeLayout.Outputs[PinIndex], NodeSize, true, PinIndex);
+		}
+		OutHTML.Append("</g>\n");
+	}
+
+	OutHTML.Append("</svg>\n");
+}
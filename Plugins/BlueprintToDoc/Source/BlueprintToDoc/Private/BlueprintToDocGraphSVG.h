@@ -0,0 +1,22 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FBlueprintToDocHTMLWriter;
+struct FEdGraphDocument;
+struct FEdGraphNodeLayout;
+
+/**
+ * 写し取ったノードの配置からグラフをSVGで描画する
+ * Slateや描画スレッドを使わないので、コマンドレットやワーカースレッドからでも呼べる
+ */
+class FBlueprintToDocGraphSVG
+{
+public:
+	// グラフのSVGを追加(ノードが無ければ何もしない)
+	static void Append(FBlueprintToDocHTMLWriter& OutHTML, const FEdGraphDocument& EdGraph);
+	// ノードの大きさ(エディタが保存していないノードはタイトルとピンから見積もる)
+	static FIntPoint GetNodeSize(const FEdGraphNodeLayout& NodeLayout);
+};
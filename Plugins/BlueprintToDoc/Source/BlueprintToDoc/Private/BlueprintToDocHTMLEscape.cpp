@@ -0,0 +1,403 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "BlueprintToDocHTMLEscape.h"
+
+#include "Math/RandomStream.h"
+#include "Tests/AutomationCommon.h"
+#include "Misc/AutomationTest.h"
+
+// TCHARが2バイトのx86ではSSE2で8文字ずつ調べる
+#if PLATFORM_ENABLE_VECTORINTRINSICS && !PLATFORM_ENABLE_VECTORINTRINSICS_NEON && !PLATFORM_TCHAR_IS_4_BYTES
+#define BLUEPRINTTODOC_HTMLESCAPE_SSE 1
+#include <emmintrin.h>
+#else
+#define BLUEPRINTTODOC_HTMLESCAPE_SSE 0
+#endif
+
+
+// エスケープが必要な文字を置き換えて追加
+static FORCEINLINE void AppendReplacement(FString& OutString, TCHAR Char)
+{
+	switch(Char)
+	{
+	case TEXT('&'):  OutString.AppendChars(TEXT("&amp;"), 5);   break;
+	case TEXT('<'):  OutString.AppendChars(TEXT("&lt;"), 4);    break;
+	case TEXT('>'):  OutString.AppendChars(TEXT("&gt;"), 4);    break;
+	case TEXT('"'):  OutString.AppendChars(TEXT("&quot;"), 6);  break;
+	case TEXT('\''): OutString.AppendChars(TEXT("&#39;"), 5);   break;
+	case TEXT('\n'): OutString.AppendChars(TEXT("</br>\n"), 6); break;
+	// \r\n の\rは出力しない
+	case TEXT('\r'): break;
+	default:         OutString.AppendChar(Char);                break;
+	}
+}
+
+void FBlueprintToDocHTMLEscape::Append(FString& OutString, const TCHAR* Source, int32 Length)
+{
+	const TCHAR* Cursor = Source;
+	const TCHAR* End = Source + Length;
+	// まだ追加していないエスケープ不要な文字列の先頭
+	const TCHAR* Run = Source;
+
+#if BLUEPRINTTODOC_HTMLESCAPE_SSE
+	static_assert(sizeof(TCHAR) == sizeof(uint16), "TCHAR must be 2 bytes");
+
+	const __m128i Amp = _mm_set1_epi16(TEXT('&'));
+	const __m128i Lt = _mm_set1_epi16(TEXT('<'));
+	const __m128i Gt = _mm_set1_epi16(TEXT('>'));
+	const __m128i Quot = _mm_set1_epi16(TEXT('"'));
+	const __m128i Apos = _mm_set1_epi16(TEXT('\''));
+	const __m128i Lf = _mm_set1_epi16(TEXT('\n'));
+	const __m128i Cr = _mm_set1_epi16(TEXT('\r'));
+
+	while(End - Cursor >= 8)
+	{
+		const __m128i Chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Cursor));
+		__m128i Mask = _mm_or_si128(_mm_cmpeq_epi16(Chars, Amp), _mm_cmpeq_epi16(Chars, Lt));
+		Mask = _mm_or_si128(Mask, _mm_or_si128(_mm_cmpeq_epi16(Chars, Gt), _mm_cmpeq_epi16(Chars, Quot)));
+		Mask = _mm_or_si128(Mask, _mm_or_si128(_mm_cmpeq_epi16(Chars, Apos), _mm_or_si128(_mm_cmpeq_epi16(Chars, Lf), _mm_cmpeq_epi16(Chars, Cr))));
+
+		const uint32 Bits = (uint32)_mm_movemask_epi8(Mask);
+		if(Bits == 0)
+		{
+			Cursor += 8;
+			continue;
+		}
+
+		// 1文字につき2ビット立つ
+		Cursor += FMath::CountTrailingZeros(Bits) / 2;
+		OutString.AppendChars(Run, (int32)(Cursor - Run));
+		AppendReplacement(OutString, *Cursor);
+		Run = ++Cursor;
+	}
+#endif
+
+	// 残り(SSEが無い場合は全て)
+	for(; Cursor < End; ++Cursor)
+	{
+		if(IsSpecial(*Cursor))
+		{
+			OutString.AppendChars(Run, (int32)(Cursor - Run));
+			AppendReplacement(OutString, *Cursor);
+			Run = Cursor + 1;
+		}
+	}
+	OutString.AppendChars(Run, (int32)(End - Run));
+}
+
+void FBlueprintToDocHTMLEscape::AppendScalar(FString& OutString, const TCHAR* Source, int32 Length)
+{
+	for(int32 Index = 0; Index < Length; ++Index)
+	{
+		AppendReplacement(OutString, Source[Index]);
+	}
+}
+
+// バイト列を追加
+static FORCEINLINE void AppendBytes(FBlueprintToDocUTF8Bytes& OutBytes, const void* Bytes, int32 Count)
+{
+	if(Count > 0)
+	{
+		const int32 Index = OutBytes.AddUninitialized(Count);
+		FMemory::Memcpy(OutBytes.GetData() + Index, Bytes, Count);
+	}
+}
+
+// ASCIIだけの文字列をそのままバイト列にして追加
+static FORCEINLINE void AppendASCII(FBlueprintToDocUTF8Bytes& OutBytes, const TCHAR* Source, int32 Count)
+{
+	if(Count > 0)
+	{
+		uint8* Dest = OutBytes.GetData() + OutBytes.AddUninitialized(Count);
+		for(int32 Index = 0; Index < Count; ++Index)
+		{
+			Dest[Index] = (uint8)Source[Index];
+		}
+	}
+}
+
+// 1文字をUTF-8にして追加し、読んだ文字数を返す(サロゲートペアは2)
+static int32 AppendCharUTF8(FBlueprintToDocUTF8Bytes& OutBytes, const TCHAR* Cursor, const TCHAR* End, bool bEscape)
+{
+	if(bEscape && FBlueprintToDocHTMLEscape::IsSpecial(*Cursor))
+	{
+		switch(*Cursor)
+		{
+		case TEXT('&'):  AppendBytes(OutBytes, "&amp;", 5);   break;
+		case TEXT('<'):  AppendBytes(OutBytes, "&lt;", 4);    break;
+		case TEXT('>'):  AppendBytes(OutBytes, "&gt;", 4);    break;
+		case TEXT('"'):  AppendBytes(OutBytes, "&quot;", 6);  break;
+		case TEXT('\''): AppendBytes(OutBytes, "&#39;", 5);   break;
+		case TEXT('\n'): AppendBytes(OutBytes, "</br>\n", 6); break;
+		default:         break;
+		}
+		return 1;
+	}
+
+	uint32 Codepoint = (uint32)*Cursor;
+	int32 Consumed = 1;
+	if(sizeof(TCHAR) == 2 && Codepoint >= 0xD800 && Codepoint <= 0xDFFF)
+	{
+		// サロゲートペア(対になっていなければ置換文字)
+		if(Codepoint <= 0xDBFF && Cursor + 1 < End && (uint32)Cursor[1] >= 0xDC00 && (uint32)Cursor[1] <= 0xDFFF)
+		{
+			Codepoint = 0x10000 + ((Codepoint - 0xD800) << 10) + ((uint32)Cursor[1] - 0xDC00);
+			Consumed = 2;
+		}
+		else
+		{
+			Codepoint = 0xFFFD;
+		}
+	}
+	if(Codepoint > 0x10FFFF)
+	{
+		Codepoint = 0xFFFD;
+	}
+
+	uint8 Bytes[4];
+	int32 Count;
+	if(Codepoint < 0x80)
+	{
+		Bytes[0] = (uint8)Codepoint;
+		Count = 1;
+	}
+	else if(Codepoint < 0x800)
+	{
+		Bytes[0] = (uint8)(0xC0 | (Codepoint >> 6));
+		Bytes[1] = (uint8)(0x80 | (Codepoint & 0x3F));
+		Count = 2;
+	}
+	else if(Codepoint < 0x10000)
+	{
+		Bytes[0] = (uint8)(0xE0 | (Codepoint >> 12));
+		Bytes[1] = (uint8)(0x80 | ((Codepoint >> 6) & 0x3F));
+		Bytes[2] = (uint8)(0x80 | (Codepoint & 0x3F));
+		Count = 3;
+	}
+	else
+	{
+		Bytes[0] = (uint8)(0xF0 | (Codepoint >> 18));
+		Bytes[1] = (uint8)(0x80 | ((Codepoint >> 12) & 0x3F));
+		Bytes[2] = (uint8)(0x80 | ((Codepoint >> 6) & 0x3F));
+		Bytes[3] = (uint8)(0x80 | (Codepoint & 0x3F));
+		Count = 4;
+	}
+	AppendBytes(OutBytes, Bytes, Count);
+	return Consumed;
+}
+
+void FBlueprintToDocHTMLEscape::AppendUTF8(FBlueprintToDocUTF8Bytes& OutBytes, const TCHAR* Source, int32 Length, bool bEscape)
+{
+	const TCHAR* Cursor = Source;
+	const TCHAR* End = Source + Length;
+
+#if BLUEPRINTTODOC_HTMLESCAPE_SSE
+	const __m128i Amp = _mm_set1_epi16(TEXT('&'));
+	const __m128i Lt = _mm_set1_epi16(TEXT('<'));
+	const __m128i Gt = _mm_set1_epi16(TEXT('>'));
+	const __m128i Quot = _mm_set1_epi16(TEXT('"'));
+	const __m128i Apos = _mm_set1_epi16(TEXT('\''));
+	const __m128i Lf = _mm_set1_epi16(TEXT('\n'));
+	const __m128i Cr = _mm_set1_epi16(TEXT('\r'));
+	const __m128i Zero = _mm_setzero_si128();
+	const __m128i NonASCII = _mm_set1_epi16((int16)0xFF80);
+	const __m128i EscapeMask = bEscape ? _mm_cmpeq_epi16(Zero, Zero) : Zero;
+
+	while(End - Cursor >= 8)
+	{
+		const __m128i Chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Cursor));
+		__m128i Special = _mm_or_si128(_mm_cmpeq_epi16(Chars, Amp), _mm_cmpeq_epi16(Chars, Lt));
+		Special = _mm_or_si128(Special, _mm_or_si128(_mm_cmpeq_epi16(Chars, Gt), _mm_cmpeq_epi16(Chars, Quot)));
+		Special = _mm_or_si128(Special, _mm_or_si128(_mm_cmpeq_epi16(Chars, Apos), _mm_or_si128(_mm_cmpeq_epi16(Chars, Lf), _mm_cmpeq_epi16(Chars, Cr))));
+		// ASCII以外の文字はエンコードが必要
+		const __m128i IsASCII = _mm_cmpeq_epi16(_mm_and_si128(Chars, NonASCII), Zero);
+		const __m128i Mask = _mm_or_si128(_mm_and_si128(Special, EscapeMask), _mm_andnot_si128(IsASCII, _mm_cmpeq_epi16(Zero, Zero)));
+
+		// ASCIIの部分は1バイトに詰めてそのまま追加
+		uint8 Packed[16];
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(Packed), _mm_packus_epi16(Chars, Chars));
+
+		const uint32 Bits = (uint32)_mm_movemask_epi8(Mask);
+		if(Bits == 0)
+		{
+			AppendBytes(OutBytes, Packed, 8);
+			Cursor += 8;
+			continue;
+		}
+
+		const int32 CleanCount = FMath::CountTrailingZeros(Bits) / 2;
+		AppendBytes(OutBytes, Packed, CleanCount);
+		Cursor += CleanCount;
+		Cursor += AppendCharUTF8(OutBytes, Cursor, End, bEscape);
+	}
+#endif
+
+	// 残り(SSEが無い場合は全て)
+	const TCHAR* Run = Cursor;
+	while(Cursor < End)
+	{
+		if((uint32)*Cursor < 0x80 && !(bEscape && IsSpecial(*Cursor)))
+		{
+			++Cursor;
+			continue;
+		}
+		AppendASCII(OutBytes, Run, (int32)(Cursor - Run));
+		Cursor += AppendCharUTF8(OutBytes, Cursor, End, bEscape);
+		Run = Cursor;
+	}
+	AppendASCII(OutBytes, Run, (int32)(End - Run));
+}
+
+
+// 置換を繰り返す素朴なエスケープ(テストの期待値)
+static FString EscapeHTMLByReplace(const FString& Source)
+{
+	return Source.Replace(TEXT("&"), TEXT("&amp;"))
+		.Replace(TEXT("<"), TEXT("&lt;"))
+		.Replace(TEXT(">"), TEXT("&gt;"))
+		.Replace(TEXT("\""), TEXT("&quot;"))
+		.Replace(TEXT("'"), TEXT("&#39;"))
+		.Replace(TEXT("\r"), TEXT(""))
+		.Replace(TEXT("\n"), TEXT("</br>\n"));
+}
+
+/**
+ *  テスト実行 HTMLエスケープ
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBlueprintToDocHTMLEscapeTest, "BlueprintToDoc.HTMLEscape", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter);
+bool FBlueprintToDocHTMLEscapeTest::RunTest(const FString& Parameters)
+{
+	auto Escape = [](const FString& Source)
+	{
+		FString Result;
+		FBlueprintToDocHTMLEscape::Append(Result, Source);
+		return Result;
+	};
+	auto EscapeScalar = [](const FString& Source)
+	{
+		FString Result;
+		FBlueprintToDocHTMLEscape::AppendScalar(Result, *Source, Source.Len());
+		return Result;
+	};
+
+	// 固定の入力
+	TestEqual(TEXT("Empty"), Escape(FString()), FString());
+	TestEqual(TEXT("Plain"), Escape(TEXT("Plain text without markup")), FString(TEXT("Plain text without markup")));
+	TestEqual(TEXT("Markup"), Escape(TEXT("<b>\"A\" & 'B'</b>")), FString(TEXT("&lt;b&gt;&quot;A&quot; &amp; &#39;B&#39;&lt;/b&gt;")));
+	TestEqual(TEXT("NewLine"), Escape(TEXT("Line1\r\nLine2\nLine3")), FString(TEXT("Line1</br>\nLine2</br>\nLine3")));
+	TestEqual(TEXT("Japanese"), Escape(TEXT("体力<最大値>")), FString(TEXT("体力&lt;最大値&gt;")));
+
+	// 8文字単位の境界の前後に置いた特殊文字
+	const TCHAR SpecialChars[] = { TEXT('&'), TEXT('<'), TEXT('>'), TEXT('"'), TEXT('\''), TEXT('\n'), TEXT('\r') };
+	for(TCHAR SpecialChar : SpecialChars)
+	{
+		for(int32 Position = 0; Position < 20; ++Position)
+		{
+			FString Source = FString::ChrN(20, TEXT('a'));
+			Source[Position] = SpecialChar;
+			TestEqual(FString::Printf(TEXT("Boundary %d:%d"), (int32)SpecialChar, Position), Escape(Source), EscapeHTMLByReplace(Source));
+		}
+	}
+
+	// ランダムな入力をSIMD、スカラー、置換の3通りで比べる
+	const TCHAR Alphabet[] = { TEXT('a'), TEXT('Z'), TEXT(' '), TEXT('='), TEXT('?'), TEXT('&'), TEXT('<'), TEXT('>'), TEXT('"'), TEXT('\''), TEXT('\n'), TEXT('\r'), 0x3042, 0x263C, 0x3C3C, 0x263E };
+	FRandomStream Random(20181019);
+	for(int32 Iteration = 0; Iteration < 1000; ++Iteration)
+	{
+		const int32 Length = Random.RandRange(0, 64);
+		FString Source;
+		for(int32 Index = 0; Index < Length; ++Index)
+		{
+			Source.AppendChar(Alphabet[Random.RandRange(0, ARRAY_COUNT(Alphabet) - 1)]);
+		}
+
+		const FString Expected = EscapeHTMLByReplace(Source);
+		if(!TestEqual(FString::Printf(TEXT("Random %d"), Iteration), Escape(Source), Expected)
+			|| !TestEqual(FString::Printf(TEXT("RandomScalar %d"), Iteration), EscapeScalar(Source), Expected))
+		{
+			break;
+		}
+	}
+
+	// UTF-8への変換はエンジンの変換と同じ結果になる
+	for(int32 Iteration = 0; Iteration < 1000; ++Iteration)
+	{
+		const int32 Length = Random.RandRange(0, 64);
+		FString Source;
+		for(int32 Index = 0; Index < Length; ++Index)
+		{
+			Source.AppendChar(Alphabet[Random.RandRange(0, ARRAY_COUNT(Alphabet) - 1)]);
+		}
+
+		FBlueprintToDocUTF8Bytes Bytes;
+		FBlueprintToDocHTMLEscape::AppendUTF8(Bytes, *Source, Source.Len(), false);
+		FTCHARToUTF8 Expected(*Source);
+		if(!TestTrue(FString::Printf(TEXT("UTF8 %d"), Iteration), Bytes.Num() == Expected.Length() && FMemory::Memcmp(Bytes.GetData(), Expected.Get(), Bytes.Num()) == 0))
+		{
+			break;
+		}
+
+		FBlueprintToDocUTF8Bytes EscapedBytes;
+		FBlueprintToDocHTMLEscape::AppendUTF8(EscapedBytes, *Source, Source.Len(), true);
+		FTCHARToUTF8 ExpectedEscaped(*EscapeHTMLByReplace(Source));
+		if(!TestTrue(FString::Printf(TEXT("EscapedUTF8 %d"), Iteration), EscapedBytes.Num() == ExpectedEscaped.Length() && FMemory::Memcmp(EscapedBytes.GetData(), ExpectedEscaped.Get(), EscapedBytes.Num()) == 0))
+		{
+			break;
+		}
+	}
+
+	// 既存の文字列の後ろに追加する
+	FString Appended(TEXT("<td>"));
+	FBlueprintToDocHTMLEscape::Append(Appended, TEXT("a<b"));
+	TestEqual(TEXT("Append"), Appended, FString(TEXT("<td>a&lt;b")));
+
+	return true;
+}
+
+/**
+ *  ベンチマーク HTMLエスケープ
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBlueprintToDocHTMLEscapeBenchmark, "BlueprintToDoc.HTMLEscapeBenchmark", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter);
+bool FBlueprintToDocHTMLEscapeBenchmark::RunTest(const FString& Parameters)
+{
+	// ツールチップを想定した、ほとんどがエスケープ不要な文字列
+	TArray<FString> Sources;
+	FRandomStream Random(20181019);
+	for(int32 Index = 0; Index < 4096; ++Index)
+	{
+		FString Source;
+		const int32 Length = Random.RandRange(0, 256);
+		for(int32 CharIndex = 0; CharIndex < Length; ++CharIndex)
+		{
+			const int32 Kind = Random.RandRange(0, 99);
+			Source.AppendChar(Kind == 0 ? TEXT('\n') : Kind == 1 ? TEXT('<') : Kind == 2 ? TEXT('&') : Kind < 20 ? (TCHAR)0x3042 : (TCHAR)(TEXT('a') + Kind % 26));
+		}
+		Sources.Add(MoveTemp(Source));
+	}
+
+	const int32 Iterations = 20;
+	auto Measure = [&](const TCHAR* Label, TFunctionRef<void(FString&, const FString&)> Function)
+	{
+		int32 OutputLength = 0;
+		const double StartTime = FPlatformTime::Seconds();
+		for(int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+		{
+			FString OutString;
+			for(const FString& Source : Sources)
+			{
+				OutString += TEXT("<td>");
+				Function(OutString, Source);
+				OutString += TEXT("</td>");
+			}
+			OutputLength = OutString.Len();
+		}
+		const double Milliseconds = (FPlatformTime::Seconds() - StartTime) * 1000.0 / Iterations;
+		AddInfo(FString::Printf(TEXT("%s: %.3f ms (%d chars)"), Label, Milliseconds, OutputLength));
+	};
+
+	Measure(TEXT("Replace"), [](FString& OutString, const FString& Source) { OutString += EscapeHTMLByReplace(Source); });
+	Measure(TEXT("Scalar"), [](FString& OutString, const FString& Source) { FBlueprintToDocHTMLEscape::AppendScalar(OutString, *Source, Source.Len()); });
+	Measure(TEXT("Append"), [](FString& OutString, const FString& Source) { FBlueprintToDocHTMLEscape::Append(OutString, Source); });
+
+	return true;
+}
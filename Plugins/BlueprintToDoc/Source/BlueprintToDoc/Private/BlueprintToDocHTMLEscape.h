@@ -0,0 +1,33 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BlueprintToDocArena.h"
+
+/**
+ * HTMLのテキストとして出力する文字列のエスケープ
+ * & < > " ' を文字参照に、改行を</br>にする(\rは出力しない)
+ */
+class FBlueprintToDocHTMLEscape
+{
+public:
+	// エスケープしてOutStringに追加
+	static void Append(FString& OutString, const TCHAR* Source, int32 Length);
+	static void Append(FString& OutString, const FString& Source)
+	{
+		Append(OutString, *Source, Source.Len());
+	}
+
+	// SIMDを使わない実装(テストと比較用)
+	static void AppendScalar(FString& OutString, const TCHAR* Source, int32 Length);
+
+	// UTF-8にしてOutBytesに追加(bEscapeならエスケープも行う)
+	static void AppendUTF8(FBlueprintToDocUTF8Bytes& OutBytes, const TCHAR* Source, int32 Length, bool bEscape);
+
+	// エスケープが必要な文字か
+	static FORCEINLINE bool IsSpecial(TCHAR Char)
+	{
+		return Char == TEXT('&') || Char == TEXT('<') || Char == TEXT('>') || Char == TEXT('"') || Char == TEXT('\'') || Char == TEXT('\n') || Char == TEXT('\r');
+	}
+};
@@ -0,0 +1,177 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "BlueprintToDocHTMLWriter.h"
+#include "BlueprintToDocHTMLEscape.h"
+
+#include "HAL/FileManager.h"
+#include "Math/RandomStream.h"
+#include "Serialization/Archive.h"
+#include "Tests/AutomationCommon.h"
+#include "Misc/AutomationTest.h"
+
+
+// ドキュメントテンプレート
+static const ANSICHAR HTMLHeader[] = "<!DOCTYPE html><html><head><meta charset=\"utf-8\"><title></title><link href=\"../layout.css\" rel=\"stylesheet\" type=\"text/css\"></head><body>\n";
+static const ANSICHAR HTMLFooter[] = "\n</body></html>";
+
+
+void FBlueprintToDocHTMLWriter::AppendUTF8(const ANSICHAR* Source, int32 Length)
+{
+	if(Length > 0)
+	{
+		const int32 Index = Bytes.AddUninitialized(Length);
+		FMemory::Memcpy(Bytes.GetData() + Index, Source, Length);
+	}
+}
+
+void FBlueprintToDocHTMLWriter::Append(const FString& Text)
+{
+	FBlueprintToDocHTMLEscape::AppendUTF8(Bytes, *Text, Text.Len(), false);
+}
+
+void FBlueprintToDocHTMLWriter::Append(FName Name)
+{
+	if(!Name.IsNone())
+	{
+		Append(Name.ToString());
+	}
+}
+
+void FBlueprintToDocHTMLWriter::Append(const FBlueprintToDocHTMLWriter& Other)
+{
+	Bytes.Append(Other.Bytes);
+}
+
+void FBlueprintToDocHTMLWriter::AppendEscaped(const FString& Text)
+{
+	FBlueprintToDocHTMLEscape::AppendUTF8(Bytes, *Text, Text.Len(), true);
+}
+
+void FBlueprintToDocHTMLWriter::AppendEscaped(FName Name)
+{
+	if(!Name.IsNone())
+	{
+		AppendEscaped(Name.ToString());
+	}
+}
+
+void FBlueprintToDocHTMLWriter::AppendInt(int64 Value)
+{
+	ANSICHAR Buffer[24];
+	const int32 Length = FCStringAnsi::Sprintf(Buffer, "%lld", Value);
+	AppendUTF8(Buffer, Length);
+}
+
+void FBlueprintToDocHTMLWriter::PageToHTML(TArray<uint8>& OutBytes) const
+{
+	OutBytes.Reset(sizeof(HTMLHeader) - 1 + Bytes.Num() + sizeof(HTMLFooter) - 1);
+	OutBytes.Append((const uint8*)HTMLHeader, sizeof(HTMLHeader) - 1);
+	OutBytes.Append(Bytes);
+	OutBytes.Append((const uint8*)HTMLFooter, sizeof(HTMLFooter) - 1);
+}
+
+bool FBlueprintToDocHTMLWriter::SavePage(const FString& Path) const
+{
+	TUniquePtr<FArchive> Writer(IFileManager::Get().CreateFileWriter(*Path));
+	if(!Writer)
+	{
+		return false;
+	}
+
+	// 本文はコピーせずにそのまま書き込む
+	Writer->Serialize((void*)HTMLHeader, sizeof(HTMLHeader) - 1);
+	Writer->Serialize((void*)Bytes.GetData(), Bytes.Num());
+	Writer->Serialize((void*)HTMLFooter, sizeof(HTMLFooter) - 1);
+	return Writer->Close();
+}
+
+
+/**
+ *  ベンチマーク UTF-8で直接組み立てる場合とFStringから変換する場合
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBlueprintToDocHTMLWriterBenchmark, "BlueprintToDoc.HTMLWriterBenchmark", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter);
+bool FBlueprintToDocHTMLWriterBenchmark::RunTest(const FString& Parameters)
+{
+	// 日本語のツールチップを持つプロパティの行
+	struct FRow
+	{
+		FString Name;
+		FString Type;
+		FString ToolTip;
+	};
+	TArray<FRow> Rows;
+	FRandomStream Random(20181019);
+	for(int32 Index = 0; Index < 8192; ++Index)
+	{
+		FRow Row;
+		Row.Name = FString::Printf(TEXT("Property_%d"), Index);
+		Row.Type = (Index % 3 == 0) ? TEXT("float") : TEXT("TArray<FVector>");
+		const int32 Length = Random.RandRange(0, 128);
+		for(int32 CharIndex = 0; CharIndex < Length; ++CharIndex)
+		{
+			const int32 Kind = Random.RandRange(0, 99);
+			Row.ToolTip.AppendChar(Kind == 0 ? TEXT('\n') : Kind < 60 ? (TCHAR)(0x3042 + Kind) : (TCHAR)(TEXT('a') + Kind % 26));
+		}
+		Rows.Add(MoveTemp(Row));
+	}
+
+	const int32 Iterations = 10;
+
+	// FStringで組み立てて保存時にUTF-8へ変換
+	TArray<uint8> StringBytes;
+	int64 StringPeakBytes = 0;
+	const double StringStartTime = FPlatformTime::Seconds();
+	for(int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+	{
+		FString Page;
+		Page += TEXT("<table>\n");
+		for(const FRow& Row : Rows)
+		{
+			Page += TEXT("<tr><td>");
+			FBlueprintToDocHTMLEscape::Append(Page, Row.Name);
+			Page += TEXT("</td><td>");
+			FBlueprintToDocHTMLEscape::Append(Page, Row.Type);
+			Page += TEXT("</td><td>");
+			FBlueprintToDocHTMLEscape::Append(Page, Row.ToolTip);
+			Page += TEXT("</td></tr>\n");
+		}
+		Page += TEXT("</table>\n");
+
+		FTCHARToUTF8 Converted(*Page);
+		StringBytes.Reset();
+		StringBytes.Append((const uint8*)Converted.Get(), Converted.Length());
+		StringPeakBytes = Page.GetAllocatedSize() + Converted.Length();
+	}
+	const double StringMilliseconds = (FPlatformTime::Seconds() - StringStartTime) * 1000.0 / Iterations;
+
+	// UTF-8で直接組み立てる
+	TArray<uint8> WriterBytes;
+	int64 WriterPeakBytes = 0;
+	const double WriterStartTime = FPlatformTime::Seconds();
+	for(int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+	{
+		FBlueprintToDocHTMLWriter Page;
+		Page.Append("<table>\n");
+		for(const FRow& Row : Rows)
+		{
+			Page.Append("<tr><td>");
+			Page.AppendEscaped(Row.Name);
+			Page.Append("</td><td>");
+			Page.AppendEscaped(Row.Type);
+			Page.Append("</td><td>");
+			Page.AppendEscaped(Row.ToolTip);
+			Page.Append("</td></tr>\n");
+		}
+		Page.Append("</table>\n");
+
+		WriterBytes = TArray<uint8>(Page.GetBytes());
+		WriterPeakBytes = Page.GetBytes().GetAllocatedSize();
+	}
+	const double WriterMilliseconds = (FPlatformTime::Seconds() - WriterStartTime) * 1000.0 / Iterations;
+
+	TestTrue(TEXT("SameOutput"), StringBytes == WriterBytes);
+	AddInfo(FString::Printf(TEXT("FString+Convert: %.3f ms, peak %lld bytes"), StringMilliseconds, StringPeakBytes));
+	AddInfo(FString::Printf(TEXT("UTF8Writer: %.3f ms, peak %lld bytes"), WriterMilliseconds, WriterPeakBytes));
+
+	return true;
+}
@@ -0,0 +1,45 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BlueprintToDocArena.h"
+
+/**
+ * HTMLをUTF-8のバイト列として組み立てる
+ * 保存時に変換しないように、描画の時点でUTF-8にする
+ * FBlueprintToDocArenaScope の中で作った場合はバイト列をスレッドのアリーナから確保する
+ */
+class FBlueprintToDocHTMLWriter
+{
+public:
+	// 静的なマークアップ(ASCII以外を含む場合はu8リテラルで渡す)
+	template<int32 N>
+	FORCEINLINE void Append(const ANSICHAR (&Literal)[N])
+	{
+		AppendUTF8(Literal, N - 1);
+	}
+	// UTF-8の文字列を追加
+	void AppendUTF8(const ANSICHAR* Source, int32 Length);
+	// UTF-8に変換して追加
+	void Append(const FString& Text);
+	void Append(FName Name);
+	void Append(const FBlueprintToDocHTMLWriter& Other);
+	// エスケープしてUTF-8に変換して追加
+	void AppendEscaped(const FString& Text);
+	void AppendEscaped(FName Name);
+	// 整数を追加
+	void AppendInt(int64 Value);
+
+	bool IsEmpty() const { return Bytes.Num() == 0; }
+	int32 Num() const { return Bytes.Num(); }
+	const FBlueprintToDocUTF8Bytes& GetBytes() const { return Bytes; }
+
+	// ページのテンプレートで囲んだバイト列
+	void PageToHTML(TArray<uint8>& OutBytes) const;
+	// ページのテンプレートで囲んでファイルに出力
+	bool SavePage(const FString& Path) const;
+
+private:
+	FBlueprintToDocUTF8Bytes Bytes;
+};
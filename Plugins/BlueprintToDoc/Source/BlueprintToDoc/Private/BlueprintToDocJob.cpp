@@ -0,0 +1,288 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "BlueprintToDocJob.h"
+#include "BlueprintToDoc.h"
+#include "BlueprintToDocUserSettings.h"
+#include "BlueprintToDocArena.h"
+#include "BlueprintToDocHTMLWriter.h"
+#include "BlueprintToDocLoadCost.h"
+#include "BlueprintToDocMacroCost.h"
+#include "BlueprintToDocSnapshot.h"
+
+#include "AssetRegistryModule.h"
+#include "UObject/UObjectGlobals.h"
+
+
+FBlueprintToDocJob::FBlueprintToDocJob(const FString& InRootPath, float InTimeBudgetSeconds)
+	: TimeBudgetSeconds(InTimeBudgetSeconds)
+	, State(EState::Idle)
+	, NextAssetIndex(0)
+	, NextPrefetchIndex(0)
+	, PrefetchAssetCount(0)
+	, NextTypeIndex(0)
+	, StartTime(0.0)
+	, bUseRenderArena(true)
+	, DryRunAssetCount(INDEX_NONE)
+{
+	Document.RootPath = InRootPath;
+}
+
+FBlueprintToDocJob::~FBlueprintToDocJob()
+{
+	// ページの書き込みは途中で止めない
+	if(PageTasks.Num() > 0)
+	{
+		FTaskGraphInterface::Get().WaitUntilTasksComplete(PageTasks);
+	}
+}
+
+bool FBlueprintToDocJob::Start()
+{
+	check(IsInGameThread());
+
+	if(State != EState::Idle)
+	{
+		return false;
+	}
+
+	// ドライランは選択されるアセットの数だけ出し、何も出力しない
+	const UBlueprintToDocUserSettings* Settings = GetDefault<UBlueprintToDocUserSettings>();
+	if(Settings->bDryRun)
+	{
+		DryRunAssetCount = UBlueprintToDocUtil::BlueprintToDocDryRun();
+		State = EState::Finished;
+		FinishedDelegate.ExecuteIfBound();
+		return true;
+	}
+
+	// 条件にあったアセットを取得
+	if(!UBlueprintToDocUtil::GetBlueprintAssets(Assets) || !UBlueprintToDocUtil::GetTypeAssets(TypeAssets))
+	{
+		return false;
+	}
+
+	// リンク先のページ名は抽出前に全て決めておく
+	TSharedRef<FDocumentSymbolTable, ESPMode::ThreadSafe> Symbols = MakeShared<FDocumentSymbolTable, ESPMode::ThreadSafe>();
+	UBlueprintToDocUtil::MakeSymbolTable(*Symbols, Assets, TypeAssets);
+	Document.Symbols = Symbols;
+
+	// ハード参照のロードコスト
+	FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(FName("AssetRegistry"));
+	LoadCost = MakeUnique<FBlueprintToDocLoadCost>(AssetRegistryModule.Get(), Settings->HardReferenceMemoryScale);
+	// マクロの展開したノード数(マクロライブラリは複数のブループリントで共有される)
+	MacroCost = MakeUnique<FBlueprintToDocMacroCost>();
+
+	// 抽出している間に先のアセットをロードしておく
+	PrefetchAssetCount = Settings->PrefetchAssetCount;
+	LoadRequestIds.Init(INDEX_NONE, Assets.Num());
+
+	BlueprintDocuments.Reserve(Assets.Num());
+	bUseRenderArena = Settings->bUseRenderArena;
+	FBlueprintToDocArena::SetEnabled(bUseRenderArena);
+	FBlueprintToDocArena::ResetStats();
+	StartTime = FPlatformTime::Seconds();
+	State = EState::Extracting;
+	return true;
+}
+
+void FBlueprintToDocJob::RunToCompletion()
+{
+	check(IsInGameThread());
+
+	if(State == EState::Extracting)
+	{
+		ExtractUntil(TNumericLimits<double>::Max());
+		State = EState::WaitingForPages;
+	}
+	if(State == EState::WaitingForPages)
+	{
+		FTaskGraphInterface::Get().WaitUntilTasksComplete(PageTasks);
+		Finish();
+	}
+}
+
+FString FBlueprintToDocJob::GetResultMessage() const
+{
+	if(DryRunAssetCount != INDEX_NONE)
+	{
+		return FString::Printf(TEXT("DryRun: %d assets selected"), DryRunAssetCount);
+	}
+	return TEXT("Finish！！ BlueprintToDoc");
+}
+
+float FBlueprintToDocJob::GetProgress() const
+{
+	const int32 AssetCount = Assets.Num() + TypeAssets.Num();
+	return AssetCount > 0 ? (float)(NextAssetIndex + NextTypeIndex) / (float)AssetCount : 1.0f;
+}
+
+void FBlueprintToDocJob::Tick(float DeltaTime)
+{
+	switch(State)
+	{
+	case EState::Extracting:
+		{
+			const double EndTime = TimeBudgetSeconds > 0.0f ? FPlatformTime::Seconds() + TimeBudgetSeconds : TNumericLimits<double>::Max();
+			if(ExtractUntil(EndTime))
+			{
+				State = EState::WaitingForPages;
+			}
+		}
+		break;
+
+	case EState::WaitingForPages:
+		// ゲームスレッドを止めないように完了を確認するだけにする
+		if(ArePagesWritten())
+		{
+			Finish();
+		}
+		break;
+
+	default:
+		break;
+	}
+}
+
+TStatId FBlueprintToDocJob::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(FBlueprintToDocJob, STATGROUP_Tickables);
+}
+
+bool FBlueprintToDocJob::ExtractUntil(double EndTime)
+{
+	// ロードを待つ場合以外は最低1つは進める
+	do
+	{
+		if(NextAssetIndex >= Assets.Num())
+		{
+			if(NextTypeIndex >= TypeAssets.Num())
+			{
+				return true;
+			}
+
+			// 構造体、enumは小さいのでその場で作り、ページは目次と一緒に出力する
+			FTypeDocument TypeDocument;
+			if(UBlueprintToDocUtil::MakeTypeDocument(TypeDocument, TypeAssets[NextTypeIndex++], Document.GetSymbols()))
+			{
+				Document.Types.Add(MoveTemp(TypeDocument));
+			}
+			continue;
+		}
+
+		// ロードを待つ間も先のアセットのロードと、前のアセットの整形、出力は進む
+		PrefetchAssets();
+		if(!WaitForAsset(NextAssetIndex, EndTime))
+		{
+			break;
+		}
+
+		// ゲームスレッドではUObjectから写し取るだけにする
+		const FAssetData& AssetData = Assets[NextAssetIndex++];
+		TSharedPtr<FBlueprintSnapshot, ESPMode::ThreadSafe> Snapshot = MakeShared<FBlueprintSnapshot, ESPMode::ThreadSafe>();
+		if(!UBlueprintToDocUtil::MakeBlueprintSnapshot(*Snapshot, AssetData, Document.GetSymbols(), *LoadCost, *MacroCost))
+		{
+			continue;
+		}
+		TSharedPtr<FBlueprintDocument, ESPMode::ThreadSafe> BlueprintDocument = MakeShared<FBlueprintDocument, ESPMode::ThreadSafe>();
+		BlueprintDocuments.Add(BlueprintDocument);
+
+		// 整形とページの出力はワーカースレッドで行う
+		const FString RootPath = Document.RootPath;
+		TSharedPtr<const FDocumentSymbolTable, ESPMode::ThreadSafe> Symbols = Document.Symbols;
+		PageTasks.Add(FFunctionGraphTask::CreateAndDispatchWhenReady([RootPath, Symbols, Snapshot, BlueprintDocument]()
+		{
+			UBlueprintToDocUtil::FormatBlueprintSnapshot(*BlueprintDocument, *Snapshot);
+
+			// 描画中のバッファはこのスレッドのアリーナから確保し、保存したらまとめて解放する
+			FBlueprintToDocArenaScope ArenaScope;
+			FHTMLPages Pages;
+			UBlueprintToDocUtil::BlueprintPageHTML(Pages, *BlueprintDocument, *Symbols);
+			UBlueprintToDocUtil::SaveHTMLPages(RootPath, Pages);
+		}, TStatId(), nullptr, ENamedThreads::AnyBackgroundThreadNormalTask));
+	}
+	while(FPlatformTime::Seconds() < EndTime);
+
+	UE_LOG(LogBlueprintToDoc, Verbose, TEXT("Extracted %d/%d"), NextAssetIndex + NextTypeIndex, Assets.Num() + TypeAssets.Num());
+	return NextAssetIndex >= Assets.Num() && NextTypeIndex >= TypeAssets.Num();
+}
+
+void FBlueprintToDocJob::PrefetchAssets()
+{
+	NextPrefetchIndex = FMath::Max(NextPrefetchIndex, NextAssetIndex);
+	const int32 PrefetchEnd = FMath::Min(NextAssetIndex + PrefetchAssetCount, Assets.Num());
+	for(; NextPrefetchIndex < PrefetchEnd; ++NextPrefetchIndex)
+	{
+		const FAssetData& AssetData = Assets[NextPrefetchIndex];
+		if(!AssetData.IsAssetLoaded())
+		{
+			LoadRequestIds[NextPrefetchIndex] = LoadPackageAsync(AssetData.PackageName.ToString());
+		}
+	}
+}
+
+bool FBlueprintToDocJob::WaitForAsset(int32 AssetIndex, double EndTime)
+{
+	// 要求していないものは抽出するときに同期ロードする
+	const int32 LoadRequestId = LoadRequestIds[AssetIndex];
+	const FName PackageName = Assets[AssetIndex].PackageName;
+	if(LoadRequestId == INDEX_NONE || GetAsyncLoadPercentage(PackageName) < 0.0f)
+	{
+		return true;
+	}
+
+	// 時間の制限が無い場合はこのパッケージまでロードする
+	if(EndTime == TNumericLimits<double>::Max())
+	{
+		FlushAsyncLoading(LoadRequestId);
+		return true;
+	}
+
+	// 同期ロードすると非同期ロード中のパッケージをまとめて待つので、残りの時間だけ非同期ロードを進める
+	const float RemainingTime = (float)(EndTime - FPlatformTime::Seconds());
+	ProcessAsyncLoading(true, false, FMath::Max(RemainingTime, 0.001f));
+	return GetAsyncLoadPercentage(PackageName) < 0.0f;
+}
+
+bool FBlueprintToDocJob::ArePagesWritten() const
+{
+	for(const FGraphEventRef& PageTask : PageTasks)
+	{
+		if(!PageTask->IsComplete())
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+void FBlueprintToDocJob::Finish()
+{
+	PageTasks.Reset();
+	LoadCost.Reset();
+	MacroCost.Reset();
+
+	// ワーカースレッドで整形したブループリント
+	Document.Blueprints.Reserve(BlueprintDocuments.Num());
+	for(const TSharedPtr<FBlueprintDocument, ESPMode::ThreadSafe>& BlueprintDocument : BlueprintDocuments)
+	{
+		Document.Blueprints.Add(MoveTemp(*BlueprintDocument));
+	}
+	BlueprintDocuments.Reset();
+
+	// 目次とレポート
+	{
+		FBlueprintToDocArenaScope ArenaScope;
+		UBlueprintToDocUtil::IndexToHTML(Document);
+	}
+
+	// データファイル
+	UBlueprintToDocUtil::ExportData(Document);
+
+	// 実行の結果 ヒープの確保回数は計測した値で、bUseRenderArenaを無効にして実行するとアリーナが無い場合の回数になる
+	const FBlueprintToDocArena::FStats ArenaStats = FBlueprintToDocArena::GetStats();
+	UE_LOG(LogBlueprintToDoc, Display, TEXT("Documented %d blueprints, %d types in %.2f s"), Document.Blueprints.Num(), Document.Types.Num(), FPlatformTime::Seconds() - StartTime);
+	UE_LOG(LogBlueprintToDoc, Display, TEXT("Render scratch allocations (arena %s): %d heap allocations, %d arena requests, %d arena blocks from heap (%.1f MB)"), bUseRenderArena ? TEXT("on") : TEXT("off"), ArenaStats.HeapAllocationCount, ArenaStats.AllocationCount, ArenaStats.BlockCount, ArenaStats.BlockBytes / (1024.0 * 1024.0));
+
+	State = EState::Finished;
+	FinishedDelegate.ExecuteIfBound();
+}
@@ -0,0 +1,156 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "BlueprintToDocLoadCost.h"
+
+#include "AssetRegistryModule.h"
+#include "Misc/PackageName.h"
+#include "UObject/Package.h"
+#include "UObject/UObjectHash.h"
+
+
+FBlueprintToDocLoadCost::FBlueprintToDocLoadCost(IAssetRegistry& InAssetRegistry, float InMemoryScale)
+	: AssetRegistry(InAssetRegistry)
+	, MemoryScale(InMemoryScale)
+	, NextIndex(0)
+{
+}
+
+void FBlueprintToDocLoadCost::GetClosureSize(FName PackageName, int32& OutPackageCount, int64& OutDiskSize, int64& OutMemorySize)
+{
+	if(!Closures.Contains(PackageName))
+	{
+		Visit(PackageName);
+	}
+
+	const TSharedPtr<FClosure>& Closure = Closures.FindChecked(PackageName);
+	OutPackageCount = Closure->Packages.Num();
+	OutDiskSize = Closure->DiskSize;
+	OutMemorySize = Closure->MemorySize;
+}
+
+void FBlueprintToDocLoadCost::Visit(FName PackageName)
+{
+	const int32 Index = NextIndex++;
+	VisitIndex.Add(PackageName, Index);
+	LowLink.Add(PackageName, Index);
+	VisitStack.Push(PackageName);
+	OnStack.Add(PackageName);
+
+	// ハード参照のみを辿る
+	// 再帰中にマップが再確保されるのでローカルに持つ
+	TArray<FName> PackageDependencies;
+	AssetRegistry.GetDependencies(PackageName, PackageDependencies, EAssetRegistryDependencyType::Hard);
+	PackageDependencies.RemoveAll([this](FName Dependency) { return IsIgnorePackage(Dependency); });
+	Dependencies.Add(PackageName, PackageDependencies);
+
+	for(FName Dependency : PackageDependencies)
+	{
+		if(Closures.Contains(Dependency))
+		{
+			// 計算済みの強連結成分
+			continue;
+		}
+
+		if(!VisitIndex.Contains(Dependency))
+		{
+			Visit(Dependency);
+			LowLink[PackageName] = FMath::Min(LowLink[PackageName], LowLink[Dependency]);
+		}
+		else if(OnStack.Contains(Dependency))
+		{
+			LowLink[PackageName] = FMath::Min(LowLink[PackageName], VisitIndex[Dependency]);
+		}
+	}
+
+	// 強連結成分の根でなければ閉包は後でまとめて作る
+	if(LowLink[PackageName] != Index)
+	{
+		return;
+	}
+
+	TArray<FName> Members;
+	FName Member;
+	do
+	{
+		Member = VisitStack.Pop(false);
+		OnStack.Remove(Member);
+		Members.Add(Member);
+	} while(Member != PackageName);
+
+	// 成分内のパッケージと、参照先の閉包(計算済み)を合わせる
+	TSharedPtr<FClosure> Closure = MakeShareable(new FClosure());
+	Closure->Packages.Append(Members);
+	for(FName SccMember : Members)
+	{
+		for(FName Dependency : Dependencies.FindChecked(SccMember))
+		{
+			if(Closure->Packages.Contains(Dependency))
+			{
+				continue;
+			}
+			const TSharedPtr<FClosure>* DependencyClosure = Closures.Find(Dependency);
+			if(DependencyClosure != nullptr)
+			{
+				Closure->Packages.Append((*DependencyClosure)->Packages);
+			}
+		}
+	}
+
+	for(FName ClosurePackage : Closure->Packages)
+	{
+		const TPair<int64, int64>& PackageSize = GetPackageSize(ClosurePackage);
+		Closure->DiskSize += PackageSize.Key;
+		Closure->MemorySize += PackageSize.Value;
+	}
+
+	for(FName SccMember : Members)
+	{
+		Closures.Add(SccMember, Closure);
+		Dependencies.Remove(SccMember);
+	}
+}
+
+bool FBlueprintToDocLoadCost::IsIgnorePackage(FName PackageName) const
+{
+	// ネイティブクラスのパッケージはディスク上に存在しない
+	return FPackageName::IsScriptPackage(PackageName.ToString());
+}
+
+const TPair<int64, int64>& FBlueprintToDocLoadCost::GetPackageSize(FName PackageName)
+{
+	if(const TPair<int64, int64>* PackageSize = PackageSizes.Find(PackageName))
+	{
+		return *PackageSize;
+	}
+
+	const int64 DiskSize = GetPackageDiskSize(PackageName);
+	return PackageSizes.Add(PackageName, TPair<int64, int64>(DiskSize, GetPackageMemorySize(PackageName, DiskSize)));
+}
+
+int64 FBlueprintToDocLoadCost::GetPackageDiskSize(FName PackageName) const
+{
+	const FAssetPackageData* PackageData = AssetRegistry.GetAssetPackageData(PackageName);
+	if(PackageData == nullptr || PackageData->DiskSize < 0)
+	{
+		return 0;
+	}
+	return PackageData->DiskSize;
+}
+
+int64 FBlueprintToDocLoadCost::GetPackageMemorySize(FName PackageName, int64 DiskSize) const
+{
+	// ロード済みであれば実際のオブジェクトから計算する
+	UPackage* Package = FindObjectFast<UPackage>(nullptr, PackageName);
+	if(Package == nullptr)
+	{
+		return (int64)(DiskSize * MemoryScale);
+	}
+
+	int64 MemorySize = 0;
+	ForEachObjectWithOuter(Package, [&MemorySize](UObject* Object)
+	{
+		MemorySize += Object->GetClass()->GetStructureSize();
+		MemorySize += Object->GetResourceSizeBytes(EResourceSizeMode::Exclusive);
+	});
+	return MemorySize;
+}
@@ -0,0 +1,58 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class IAssetRegistry;
+
+/**
+ * ハード参照の推移閉包からロードコストを計算する
+ * 閉包は強連結成分ごとにメモ化し、複数のブループリントで共有される部分は一度だけ計算する
+ */
+class FBlueprintToDocLoadCost
+{
+public:
+	FBlueprintToDocLoadCost(IAssetRegistry& InAssetRegistry, float InMemoryScale);
+
+	// パッケージのハード参照閉包(自身を含む)のサイズを取得
+	void GetClosureSize(FName PackageName, int32& OutPackageCount, int64& OutDiskSize, int64& OutMemorySize);
+
+private:
+	// 強連結成分ごとの閉包
+	struct FClosure
+	{
+		TSet<FName> Packages;
+		int64 DiskSize = 0;
+		int64 MemorySize = 0;
+	};
+
+	// Tarjanの強連結成分分解
+	void Visit(FName PackageName);
+	// 閉包の対象外とするパッケージ
+	bool IsIgnorePackage(FName PackageName) const;
+	// パッケージ単体のディスクサイズと推定メモリサイズ(パッケージごとにメモ化)
+	const TPair<int64, int64>& GetPackageSize(FName PackageName);
+	// パッケージ単体のディスクサイズ
+	int64 GetPackageDiskSize(FName PackageName) const;
+	// パッケージ単体の推定メモリサイズ
+	int64 GetPackageMemorySize(FName PackageName, int64 DiskSize) const;
+
+	IAssetRegistry& AssetRegistry;
+	float MemoryScale;
+
+	// 計算済みの閉包
+	TMap<FName, TSharedPtr<FClosure>> Closures;
+	// 計算済みのパッケージ単体のサイズ(ディスク、メモリ)
+	// 共有される部分の閉包は参照元の強連結成分ごとに足し直すので、パッケージの走査は一度だけにする
+	TMap<FName, TPair<int64, int64>> PackageSizes;
+	// 依存パッケージのキャッシュ
+	TMap<FName, TArray<FName>> Dependencies;
+
+	// Tarjan用
+	TMap<FName, int32> VisitIndex;
+	TMap<FName, int32> LowLink;
+	TArray<FName> VisitStack;
+	TSet<FName> OnStack;
+	int32 NextIndex;
+};
@@ -0,0 +1,59 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "BlueprintToDocMacroCost.h"
+
+#include "EdGraph/EdGraph.h"
+#include "EdGraphNode_Comment.h"
+#include "K2Node_Composite.h"
+#include "K2Node_Knot.h"
+#include "K2Node_MacroInstance.h"
+#include "K2Node_Tunnel.h"
+
+
+int32 FBlueprintToDocMacroCost::GetExpandedNodeCount(const UEdGraph* MacroGraph)
+{
+	const FName MacroPath(*MacroGraph->GetPathName());
+	if(const int32* ExpandedNodeCount = ExpandedNodeCounts.Find(MacroPath))
+	{
+		return *ExpandedNodeCount;
+	}
+
+	// マクロは自身を展開できないが、壊れたアセットで無限に辿らないように計算中は0にしておく
+	ExpandedNodeCounts.Add(MacroPath, 0);
+	const int32 ExpandedNodeCount = CountGraphNodes(MacroGraph);
+	// 再帰中にマップが再確保されるので追加し直す
+	ExpandedNodeCounts.Add(MacroPath, ExpandedNodeCount);
+	return ExpandedNodeCount;
+}
+
+int32 FBlueprintToDocMacroCost::CountGraphNodes(const UEdGraph* EdGraph)
+{
+	int32 NodeCount = 0;
+	for(const UEdGraphNode* Node : EdGraph->Nodes)
+	{
+		if(const UK2Node_MacroInstance* MacroInstance = Cast<const UK2Node_MacroInstance>(Node))
+		{
+			if(const UEdGraph* MacroGraph = MacroInstance->GetMacroGraph())
+			{
+				NodeCount += GetExpandedNodeCount(MacroGraph);
+			}
+			continue;
+		}
+		if(const UK2Node_Composite* Composite = Cast<const UK2Node_Composite>(Node))
+		{
+			if(Composite->BoundGraph != nullptr)
+			{
+				NodeCount += CountGraphNodes(Composite->BoundGraph);
+			}
+			continue;
+		}
+
+		// 入口と出口(MacroInstanceとComposite以外のTunnel)、コメント、リルートはコードにならない
+		if(Node->IsA<UK2Node_Tunnel>() || Node->IsA<UEdGraphNode_Comment>() || Node->IsA<UK2Node_Knot>())
+		{
+			continue;
+		}
+		++NodeCount;
+	}
+	return NodeCount;
+}
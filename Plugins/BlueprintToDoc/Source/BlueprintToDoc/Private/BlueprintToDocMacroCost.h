@@ -0,0 +1,25 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UEdGraph;
+
+/**
+ * マクロを展開したときのノード数を計算する
+ * マクロごとにメモ化し、入れ子のマクロは展開したノード数で数える
+ */
+class FBlueprintToDocMacroCost
+{
+public:
+	// マクロを1回展開したときのノード数(入口、出口、コメント、リルートは除く)
+	int32 GetExpandedNodeCount(const UEdGraph* MacroGraph);
+
+private:
+	// グラフのノード数(マクロは展開し、折りたたんだグラフは中を数える)
+	int32 CountGraphNodes(const UEdGraph* EdGraph);
+
+	// 計算済みのマクロのグラフのパス → ノード数
+	TMap<FName, int32> ExpandedNodeCounts;
+};
@@ -0,0 +1,233 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "BlueprintToDocPropertyTable.h"
+#include "BlueprintToDoc.h"
+#include "BlueprintToDocUtil.h"
+
+#include "HAL/FileManager.h"
+#include "Misc/Compression.h"
+
+
+namespace BlueprintToDocPropertyTable
+{
+	// 圧縮する単位
+	static const int32 ChunkSize = 256 * 1024;
+
+	// 列指向バイナリのヘッダ
+	static const uint32 ColumnarMagic = 0x4C4F4342; // "BCOL"
+	static const uint32 ColumnarVersion = 1;
+
+	// 列の型
+	enum class EColumnType : uint8
+	{
+		String,
+		Int64,
+		UInt8,
+	};
+
+	// UTF-8に変換してバッファに追加
+	static void AppendUTF8(TArray<ANSICHAR>& Buffer, const FString& Value)
+	{
+		FTCHARToUTF8 Converter(*Value, Value.Len());
+		Buffer.Append(Converter.Get(), Converter.Length());
+	}
+
+	// CSVのフィールドを追加(必要な場合のみクォートする)
+	static void AppendField(TArray<ANSICHAR>& Buffer, const FString& Value)
+	{
+		int32 QuoteIndex = INDEX_NONE;
+		const bool bNeedQuote = Value.FindChar(TEXT(','), QuoteIndex) || Value.FindChar(TEXT('"'), QuoteIndex) || Value.FindChar(TEXT('\n'), QuoteIndex) || Value.FindChar(TEXT('\r'), QuoteIndex);
+		if(!bNeedQuote)
+		{
+			AppendUTF8(Buffer, Value);
+			return;
+		}
+		Buffer.Add('"');
+		AppendUTF8(Buffer, Value.Replace(TEXT("\""), TEXT("\"\"")));
+		Buffer.Add('"');
+	}
+
+	// バッファをgzipの1メンバーとして書き出す
+	static bool FlushCompressed(FArchive& Writer, TArray<ANSICHAR>& Buffer, TArray<uint8>& CompressedBuffer)
+	{
+		if(Buffer.Num() == 0)
+		{
+			return true;
+		}
+
+		int32 CompressedSize = FCompression::CompressMemoryBound(COMPRESS_GZIP, Buffer.Num());
+		CompressedBuffer.SetNumUninitialized(CompressedSize, false);
+		if(!FCompression::CompressMemory(COMPRESS_GZIP, CompressedBuffer.GetData(), CompressedSize, Buffer.GetData(), Buffer.Num()))
+		{
+			return false;
+		}
+		Writer.Serialize(CompressedBuffer.GetData(), CompressedSize);
+		Buffer.Reset();
+		return true;
+	}
+
+	// 列を書き出す
+	template<typename T>
+	static void WriteColumn(FArchive& Writer, const TCHAR* Name, EColumnType Type, const TArray<T>& Column)
+	{
+		FTCHARToUTF8 NameUTF8(Name);
+		uint32 NameLength = NameUTF8.Length();
+		Writer << NameLength;
+		Writer.Serialize((void*)NameUTF8.Get(), NameLength);
+		uint8 TypeValue = (uint8)Type;
+		Writer << TypeValue;
+		Writer.Serialize((void*)Column.GetData(), Column.Num() * sizeof(T));
+	}
+}
+
+void FBlueprintToDocPropertyTable::Build(const FDocument& Document)
+{
+	int32 RowCount = 0;
+	for(const FBlueprintDocument& BlueprintDocument : Document.Blueprints)
+	{
+		RowCount += BlueprintDocument.Properties.Num();
+	}
+
+	NameColumn.Reserve(RowCount);
+	TypeColumn.Reserve(RowCount);
+	CategoryColumn.Reserve(RowCount);
+	FlagColumn.Reserve(RowCount);
+	LifetimeConditionColumn.Reserve(RowCount);
+	DefaultValueColumn.Reserve(RowCount);
+	BlueprintColumn.Reserve(RowCount);
+	ContentPathColumn.Reserve(RowCount);
+
+	for(const FBlueprintDocument& BlueprintDocument : Document.Blueprints)
+	{
+		const int32 BlueprintIndex = Intern(BlueprintDocument.Name);
+		const int32 ContentPathIndex = Intern(BlueprintDocument.ContentPath);
+
+		for(const FPropertyDocument& PropertyDocument : BlueprintDocument.Properties)
+		{
+			NameColumn.Add(Intern(PropertyDocument.Name));
+			TypeColumn.Add(Intern(PropertyDocument.Type));
+			CategoryColumn.Add(Intern(PropertyDocument.Category));
+			FlagColumn.Add(PropertyDocument.PropertyFlg);
+			LifetimeConditionColumn.Add((uint8)PropertyDocument.LifetimeCondition);
+			DefaultValueColumn.Add(Intern(PropertyDocument.DefaultValue));
+			BlueprintColumn.Add(BlueprintIndex);
+			ContentPathColumn.Add(ContentPathIndex);
+		}
+	}
+}
+
+bool FBlueprintToDocPropertyTable::ExportCSV(const FString& Path) const
+{
+	using namespace BlueprintToDocPropertyTable;
+
+	TUniquePtr<FArchive> Writer(IFileManager::Get().CreateFileWriter(*Path));
+	if(!Writer)
+	{
+		UE_LOG(LogBlueprintToDoc, Error, TEXT("Failed Save File:%s"), *Path);
+		return false;
+	}
+
+	TArray<ANSICHAR> Buffer;
+	TArray<uint8> CompressedBuffer;
+	Buffer.Reserve(ChunkSize + 4096);
+
+	static const ANSICHAR Header[] = "Name,Type,Category,Flag,LifetimeCondition,DefaultValue,Blueprint,ContentPath\n";
+	Buffer.Append(Header, sizeof(Header) - 1);
+
+	for(int32 Row = 0; Row < Num(); ++Row)
+	{
+		AppendField(Buffer, Strings[NameColumn[Row]]);
+		Buffer.Add(',');
+		AppendField(Buffer, Strings[TypeColumn[Row]]);
+		Buffer.Add(',');
+		AppendField(Buffer, Strings[CategoryColumn[Row]]);
+		Buffer.Add(',');
+		AppendUTF8(Buffer, FString::Printf(TEXT("0x%016llx"), FlagColumn[Row]));
+		Buffer.Add(',');
+		AppendUTF8(Buffer, FString::FromInt(LifetimeConditionColumn[Row]));
+		Buffer.Add(',');
+		AppendField(Buffer, Strings[DefaultValueColumn[Row]]);
+		Buffer.Add(',');
+		AppendField(Buffer, Strings[BlueprintColumn[Row]]);
+		Buffer.Add(',');
+		AppendField(Buffer, Strings[ContentPathColumn[Row]]);
+		Buffer.Add('\n');
+
+		// 一定サイズごとに圧縮して書き出す
+		if(Buffer.Num() >= ChunkSize && !FlushCompressed(*Writer, Buffer, CompressedBuffer))
+		{
+			UE_LOG(LogBlueprintToDoc, Error, TEXT("Failed Compress File:%s"), *Path);
+			return false;
+		}
+	}
+
+	if(!FlushCompressed(*Writer, Buffer, CompressedBuffer))
+	{
+		UE_LOG(LogBlueprintToDoc, Error, TEXT("Failed Compress File:%s"), *Path);
+		return false;
+	}
+	return Writer->Close();
+}
+
+bool FBlueprintToDocPropertyTable::ExportColumnar(const FString& Path) const
+{
+	using namespace BlueprintToDocPropertyTable;
+
+	TUniquePtr<FArchive> Writer(IFileManager::Get().CreateFileWriter(*Path));
+	if(!Writer)
+	{
+		UE_LOG(LogBlueprintToDoc, Error, TEXT("Failed Save File:%s"), *Path);
+		return false;
+	}
+
+	// ヘッダ
+	uint32 Magic = ColumnarMagic;
+	uint32 Version = ColumnarVersion;
+	uint32 RowCount = Num();
+	uint32 ColumnCount = 8;
+	uint32 StringCount = Strings.Num();
+	*Writer << Magic << Version << RowCount << ColumnCount << StringCount;
+
+	// 文字列テーブル
+	for(const FString& Value : Strings)
+	{
+		FTCHARToUTF8 ValueUTF8(*Value, Value.Len());
+		uint32 Length = ValueUTF8.Length();
+		*Writer << Length;
+		Writer->Serialize((void*)ValueUTF8.Get(), Length);
+	}
+
+	// 列
+	WriteColumn(*Writer, TEXT("Name"), EColumnType::String, NameColumn);
+	WriteColumn(*Writer, TEXT("Type"), EColumnType::String, TypeColumn);
+	WriteColumn(*Writer, TEXT("Category"), EColumnType::String, CategoryColumn);
+	WriteColumn(*Writer, TEXT("Flag"), EColumnType::Int64, FlagColumn);
+	WriteColumn(*Writer, TEXT("LifetimeCondition"), EColumnType::UInt8, LifetimeConditionColumn);
+	WriteColumn(*Writer, TEXT("DefaultValue"), EColumnType::String, DefaultValueColumn);
+	WriteColumn(*Writer, TEXT("Blueprint"), EColumnType::String, BlueprintColumn);
+	WriteColumn(*Writer, TEXT("ContentPath"), EColumnType::String, ContentPathColumn);
+
+	return Writer->Close();
+}
+
+int32 FBlueprintToDocPropertyTable::Intern(const FString& Value)
+{
+	if(const int32* Index = StringIndices.Find(Value))
+	{
+		return *Index;
+	}
+	const int32 Index = Strings.Add(Value);
+	StringIndices.Add(Value, Index);
+	return Index;
+}
+
+int32 FBlueprintToDocPropertyTable::Intern(FName Value)
+{
+	if(const int32* Index = NameIndices.Find(Value))
+	{
+		return *Index;
+	}
+	const int32 Index = Intern(UBlueprintToDocUtil::NameToString(Value));
+	NameIndices.Add(Value, Index);
+	return Index;
+}
@@ -0,0 +1,47 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FDocument;
+
+/**
+ * 全プロパティの列指向テーブル
+ * 文字列の列は文字列テーブルへのインデックスとして持つ
+ */
+class FBlueprintToDocPropertyTable
+{
+public:
+	// ドキュメントからテーブルを作る
+	void Build(const FDocument& Document);
+
+	// 行数
+	int32 Num() const { return NameColumn.Num(); }
+
+	// gzip圧縮したCSVを出力
+	bool ExportCSV(const FString& Path) const;
+	// 列指向のバイナリを出力
+	bool ExportColumnar(const FString& Path) const;
+
+private:
+	// 文字列をテーブルに登録してインデックスを返す
+	int32 Intern(const FString& Value);
+	// FNameは文字列にする前にインデックスで引く
+	int32 Intern(FName Value);
+
+	// 文字列テーブル
+	TArray<FString> Strings;
+	TMap<FString, int32> StringIndices;
+	TMap<FName, int32> NameIndices;
+
+	// 列
+	TArray<int32> NameColumn;
+	TArray<int32> TypeColumn;
+	TArray<int32> CategoryColumn;
+	TArray<int64> FlagColumn;
+	TArray<uint8> LifetimeConditionColumn;
+	TArray<int32> DefaultValueColumn;
+	TArray<int32> BlueprintColumn;
+	TArray<int32> ContentPathColumn;
+};
@@ -0,0 +1,666 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "BlueprintToDocServer.h"
+#include "BlueprintToDoc.h"
+#include "BlueprintToDocUserSettings.h"
+#include "BlueprintToDocArena.h"
+#include "BlueprintToDocHTMLWriter.h"
+#include "BlueprintToDocLoadCost.h"
+#include "BlueprintToDocMacroCost.h"
+#include "BlueprintToDocSnapshot.h"
+
+#include "AssetRegistryModule.h"
+#include "Async/Async.h"
+#include "Common/TcpListener.h"
+#include "FileHelper.h"
+#include "HAL/Event.h"
+#include "Interfaces/IPv4/IPv4Endpoint.h"
+#include "Sockets.h"
+#include "SocketSubsystem.h"
+#include "UObject/Package.h"
+
+
+// 受け付けるリクエストヘッダの最大サイズ
+static const int32 MaxRequestSize = 8 * 1024;
+
+
+// %XX 形式のURLをデコードする(UTF-8)
+static FString DecodeURL(const FString& Source)
+{
+	TArray<ANSICHAR> Bytes;
+	for(int32 Index = 0; Index < Source.Len(); ++Index)
+	{
+		const TCHAR Char = Source[Index];
+		if(Char == TEXT('%') && Index + 2 < Source.Len() && FChar::IsHexDigit(Source[Index + 1]) && FChar::IsHexDigit(Source[Index + 2]))
+		{
+			Bytes.Add((ANSICHAR)((FParse::HexDigit(Source[Index + 1]) << 4) | FParse::HexDigit(Source[Index + 2])));
+			Index += 2;
+		}
+		else if(Char == TEXT('+'))
+		{
+			Bytes.Add(' ');
+		}
+		else
+		{
+			// リクエストラインはASCIIのみ
+			Bytes.Add((ANSICHAR)Char);
+		}
+	}
+	Bytes.Add('\0');
+	return FString(UTF8_TO_TCHAR(Bytes.GetData()));
+}
+
+// 全て送信する
+static bool SendAll(FSocket* Socket, const uint8* Data, int32 Count)
+{
+	while(Count > 0)
+	{
+		int32 BytesSent = 0;
+		if(!Socket->Send(Data, Count, BytesSent) || BytesSent <= 0)
+		{
+			return false;
+		}
+		Data += BytesSent;
+		Count -= BytesSent;
+	}
+	return true;
+}
+
+
+FBlueprintToDocServer::FBlueprintToDocServer(int32 InPort, int32 InCachedPageCount)
+	: Port(InPort)
+	, CachedPageCount(FMath::Max(InCachedPageCount, 1))
+	, Listener(nullptr)
+	, PageCache(FMath::Max(InCachedPageCount, 1))
+{
+}
+
+FBlueprintToDocServer::~FBlueprintToDocServer()
+{
+	Stop();
+}
+
+bool FBlueprintToDocServer::Start()
+{
+	check(IsInGameThread());
+
+	if(Listener != nullptr)
+	{
+		return true;
+	}
+
+	TemplateDirectory = UBlueprintToDocUtil::GetHTMLTemplateDirectory();
+	bStopping = false;
+	FBlueprintToDocArena::SetEnabled(GetDefault<UBlueprintToDocUserSettings>()->bUseRenderArena);
+
+	// この時点ではアセットの一覧だけ作り、抽出はページを開いたときに行う
+	ResetLoadCost();
+	ResetDocument();
+
+	// 外部からは接続させない
+	Listener = new FTcpListener(FIPv4Endpoint(FIPv4Address(127, 0, 0, 1), Port), FTimespan::FromMilliseconds(100));
+	if(!Listener->IsActive())
+	{
+		UE_LOG(LogBlueprintToDoc, Error, TEXT("Failed Listen Port:%d"), Port);
+		delete Listener;
+		Listener = nullptr;
+		return false;
+	}
+	Listener->OnConnectionAccepted().BindRaw(this, &FBlueprintToDocServer::HandleConnectionAccepted);
+
+	PackageSavedHandle = UPackage::PackageSavedEvent.AddRaw(this, &FBlueprintToDocServer::HandlePackageSaved);
+
+	UE_LOG(LogBlueprintToDoc, Log, TEXT("BlueprintToDoc Server:http://127.0.0.1:%d/"), Port);
+	return true;
+}
+
+void FBlueprintToDocServer::Stop()
+{
+	if(Listener == nullptr)
+	{
+		return;
+	}
+
+	// 抽出待ちのリクエストを終わらせてからリスナーを止める
+	bStopping = true;
+	UPackage::PackageSavedEvent.Remove(PackageSavedHandle);
+	PackageSavedHandle.Reset();
+
+	delete Listener;
+	Listener = nullptr;
+}
+
+bool FBlueprintToDocServer::HandleConnectionAccepted(FSocket* Socket, const FIPv4Endpoint& Endpoint)
+{
+	// リクエストラインを読む
+	TArray<uint8> Request;
+	uint8 Buffer[1024];
+	while(!bStopping && Request.Num() < MaxRequestSize && !Request.Contains('\n'))
+	{
+		if(!Socket->Wait(ESocketWaitConditions::WaitForRead, FTimespan::FromSeconds(5.0)))
+		{
+			break;
+		}
+		int32 BytesRead = 0;
+		if(!Socket->Recv(Buffer, sizeof(Buffer), BytesRead) || BytesRead <= 0)
+		{
+			break;
+		}
+		Request.Append(Buffer, BytesRead);
+	}
+	Request.Add('\0');
+
+	FString RequestLine;
+	FString(UTF8_TO_TCHAR((const ANSICHAR*)Request.GetData())).Split(TEXT("\r\n"), &RequestLine, nullptr);
+
+	TArray<FString> Tokens;
+	RequestLine.ParseIntoArray(Tokens, TEXT(" "));
+
+	const TCHAR* Status = TEXT("404 Not Found");
+	FString ContentType = TEXT("text/plain; charset=utf-8");
+	TArray<uint8> Body;
+	if(Tokens.Num() < 2 || Tokens[0] != TEXT("GET"))
+	{
+		Status = TEXT("405 Method Not Allowed");
+	}
+	else
+	{
+		// クエリは使わない
+		FString RequestPath = Tokens[1];
+		RequestPath.Split(TEXT("?"), &RequestPath, nullptr);
+
+		if(HandleRequest(DecodeURL(RequestPath), ContentType, Body))
+		{
+			Status = TEXT("200 OK");
+		}
+	}
+
+	// レスポンス
+	const FString Header = FString::Printf(TEXT("HTTP/1.1 %s\r\nContent-Type: %s\r\nContent-Length: %d\r\nCache-Control: no-cache\r\nConnection: close\r\n\r\n"), Status, *ContentType, Body.Num());
+	FTCHARToUTF8 HeaderUTF8(*Header);
+	if(SendAll(Socket, (const uint8*)HeaderUTF8.Get(), HeaderUTF8.Length()))
+	{
+		SendAll(Socket, Body.GetData(), Body.Num());
+	}
+
+	Socket->Close();
+	ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->DestroySocket(Socket);
+	return true;
+}
+
+bool FBlueprintToDocServer::HandleRequest(const FString& RequestPath, FString& OutContentType, TArray<uint8>& OutBody)
+{
+	// テンプレートのファイルはそのまま返す
+	if(RequestPath == TEXT("/") || RequestPath.Equals(TEXT("/index.html"), ESearchCase::IgnoreCase))
+	{
+		OutContentType = TEXT("text/html; charset=utf-8");
+		return FFileHelper::LoadFileToArray(OutBody, *(TemplateDirectory / "index.html"));
+	}
+	if(RequestPath.Equals(TEXT("/layout.css"), ESearchCase::IgnoreCase))
+	{
+		OutContentType = TEXT("text/css; charset=utf-8");
+		return FFileHelper::LoadFileToArray(OutBody, *(TemplateDirectory / "Layout.css"));
+	}
+
+	// ブループリントのページは描画する
+	const FString PagePrefix = TEXT("/blueprint/");
+	if(!RequestPath.StartsWith(PagePrefix) || RequestPath.Contains(TEXT("..")))
+	{
+		return false;
+	}
+
+	if(!RenderPage(RequestPath.Mid(PagePrefix.Len()), OutBody))
+	{
+		return false;
+	}
+
+	OutContentType = TEXT("text/html; charset=utf-8");
+	return true;
+}
+
+bool FBlueprintToDocServer::RenderPage(const FString& PageName, TArray<uint8>& OutBody)
+{
+	{
+		FScopeLock Lock(&CacheLock);
+		if(const TArray<uint8>* CachedPage = PageCache.FindAndTouch(PageName))
+		{
+			OutBody = *CachedPage;
+			return true;
+		}
+	}
+
+	// 描画中のバッファはこのスレッドのアリーナから確保し、UTF-8のページにしたらまとめて解放する
+	FBlueprintToDocArenaScope ArenaScope;
+
+	TArray<FString> ReportPageNames;
+	UBlueprintToDocUtil::GetReportPageNames(ReportPageNames);
+
+	FHTMLPages Pages;
+	int32 Generation;
+	if(PageName == TEXT("toc.html"))
+	{
+		// 目次はアセットの一覧だけで作れる
+		FScopeLock Lock(&DocumentLock);
+		Generation = DocumentGeneration.GetValue();
+		UBlueprintToDocUtil::TOCPageHTML(Pages.Add(PageName), Document);
+	}
+	else if(ReportPageNames.Contains(PageName))
+	{
+		// レポートは全てのブループリントが必要
+		TArray<int32> Indices;
+		{
+			FScopeLock Lock(&DocumentLock);
+			for(int32 Index = 0; Index < Extracted.Num(); ++Index)
+			{
+				if(!Extracted[Index])
+				{
+					Indices.Add(Index);
+				}
+			}
+		}
+		ExtractBlueprints(Indices);
+
+		FScopeLock Lock(&DocumentLock);
+		Generation = DocumentGeneration.GetValue();
+		UBlueprintToDocUtil::ReportPagesHTML(Pages, Document);
+	}
+	else
+	{
+		int32 Index;
+		int32 TypeIndex;
+		{
+			FScopeLock Lock(&DocumentLock);
+			Index = FindBlueprintIndex(PageName);
+			TypeIndex = FindTypeIndex(PageName);
+		}
+		if(TypeIndex != INDEX_NONE)
+		{
+			ExtractType(TypeIndex);
+
+			FScopeLock Lock(&DocumentLock);
+			if(!Document.Types.IsValidIndex(TypeIndex))
+			{
+				return false;
+			}
+			Generation = DocumentGeneration.GetValue();
+			UBlueprintToDocUtil::TypePageHTML(Pages.Add(PageName), Document.Types[TypeIndex], Document.GetSymbols());
+		}
+		else if(Index != INDEX_NONE)
+		{
+			ExtractBlueprints({ Index });
+
+			FScopeLock Lock(&DocumentLock);
+			if(!Document.Blueprints.IsValidIndex(Index))
+			{
+				return false;
+			}
+			Generation = DocumentGeneration.GetValue();
+			// グラフのページも一緒に描画される
+			UBlueprintToDocUtil::BlueprintPageHTML(Pages, Document.Blueprints[Index], Document.GetSymbols());
+		}
+		else
+		{
+			return false;
+		}
+	}
+
+	const FBlueprintToDocHTMLWriter* Page = Pages.Find(PageName);
+	if(Page == nullptr)
+	{
+		return false;
+	}
+	Page->PageToHTML(OutBody);
+
+	FScopeLock Lock(&CacheLock);
+	if(Generation != DocumentGeneration.GetValue())
+	{
+		return true;
+	}
+	for(const TPair<FString, FBlueprintToDocHTMLWriter>& RenderedPage : Pages)
+	{
+		TArray<uint8> Bytes;
+		RenderedPage.Value.PageToHTML(Bytes);
+		PageCache.Add(RenderedPage.Key, MoveTemp(Bytes));
+	}
+	return true;
+}
+
+int32 FBlueprintToDocServer::FindBlueprintIndex(const FString& PageName) const
+{
+	const FString Name = PageName.EndsWith(TEXT(".html")) ? PageName.LeftChop(5) : PageName;
+	if(const int32* Index = BlueprintIndices.Find(Name))
+	{
+		return *Index;
+	}
+
+	// グラフのページは "<ブループリントのページ名>.<グラフ名>"
+	int32 Position;
+	if(Name.FindChar(TEXT('.'), Position))
+	{
+		if(const int32* Index = BlueprintIndices.Find(Name.Left(Position)))
+		{
+			return *Index;
+		}
+	}
+	return INDEX_NONE;
+}
+
+int32 FBlueprintToDocServer::FindTypeIndex(const FString& PageName) const
+{
+	const int32* Index = TypeIndices.Find(PageName.EndsWith(TEXT(".html")) ? PageName.LeftChop(5) : PageName);
+	return (Index != nullptr) ? *Index : INDEX_NONE;
+}
+
+void FBlueprintToDocServer::ResetLoadCost()
+{
+	check(IsInGameThread());
+
+	const UBlueprintToDocUserSettings* Settings = GetDefault<UBlueprintToDocUserSettings>();
+	check(Settings);
+
+	FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(FName("AssetRegistry"));
+	LoadCost = MakeUnique<FBlueprintToDocLoadCost>(AssetRegistryModule.Get(), Settings->HardReferenceMemoryScale);
+	// マクロライブラリが保存された場合も展開したノード数が変わる
+	MacroCost = MakeUnique<FBlueprintToDocMacroCost>();
+}
+
+void FBlueprintToDocServer::ResetDocument()
+{
+	check(IsInGameThread());
+
+	TArray<FAssetData> NewAssets;
+	TArray<FAssetData> NewTypeAssets;
+	UBlueprintToDocUtil::GetBlueprintAssets(NewAssets);
+	UBlueprintToDocUtil::GetTypeAssets(NewTypeAssets);
+
+	// 目次と同じ順序にしておく
+	auto AssetSorter = [](const FAssetData& A, const FAssetData& B)
+	{
+		if(A.PackagePath != B.PackagePath)
+		{
+			return A.PackagePath.ToString() < B.PackagePath.ToString();
+		}
+		return A.AssetName.ToString() < B.AssetName.ToString();
+	};
+	NewAssets.Sort(AssetSorter);
+	NewTypeAssets.Sort(AssetSorter);
+
+	// リンク先のページ名は抽出前に全て決めておく
+	TSharedRef<FDocumentSymbolTable, ESPMode::ThreadSafe> Symbols = MakeShared<FDocumentSymbolTable, ESPMode::ThreadSafe>();
+	UBlueprintToDocUtil::MakeSymbolTable(*Symbols, NewAssets, NewTypeAssets);
+
+	{
+		FScopeLock Lock(&DocumentLock);
+
+		Document.Symbols = Symbols;
+		Assets = MoveTemp(NewAssets);
+		Document.Blueprints.Reset(Assets.Num());
+		BlueprintIndices.Reset();
+		for(const FAssetData& AssetData : Assets)
+		{
+			// 抽出するまではパスと名前だけ
+			FBlueprintDocument BlueprintDocument;
+			BlueprintDocument.Name = AssetData.AssetName.ToString();
+			BlueprintDocument.PageName = Symbols->PageNames.FindChecked(AssetData.ObjectPath);
+			BlueprintDocument.ContentPath = AssetData.PackagePath.ToString();
+			BlueprintIndices.Add(BlueprintDocument.PageName, Document.Blueprints.Add(BlueprintDocument));
+		}
+		Extracted.Init(false, Assets.Num());
+
+		TypeAssets = MoveTemp(NewTypeAssets);
+		Document.Types.Reset(TypeAssets.Num());
+		TypeIndices.Reset();
+		for(const FAssetData& AssetData : TypeAssets)
+		{
+			FTypeDocument TypeDocument;
+			TypeDocument.Name = AssetData.AssetName.ToString();
+			TypeDocument.PageName = Symbols->PageNames.FindChecked(AssetData.ObjectPath);
+			TypeDocument.ContentPath = AssetData.PackagePath.ToString();
+			TypeIndices.Add(TypeDocument.PageName, Document.Types.Add(TypeDocument));
+		}
+		TypeExtracted.Init(false, TypeAssets.Num());
+		DocumentGeneration.Increment();
+	}
+
+	FScopeLock Lock(&CacheLock);
+	PageCache.Empty(CachedPageCount);
+}
+
+void FBlueprintToDocServer::ExtractBlueprints(const TArray<int32>& Indices)
+{
+	if(Indices.Num() == 0)
+	{
+		return;
+	}
+
+	// ゲームスレッドで写し取った情報
+	struct FExtractResult
+	{
+		int32 Index;
+		FName ObjectPath;
+		FBlueprintSnapshot Snapshot;
+	};
+	// 1回のタスクで写し取った分(タスクの実行中はゲームスレッドだけが触る)
+	struct FExtractBatch
+	{
+		int32 NextIndex = 0;
+		TArray<FExtractResult> Results;
+	};
+	TSharedRef<FExtractBatch, ESPMode::ThreadSafe> Batch = MakeShared<FExtractBatch, ESPMode::ThreadSafe>();
+
+	// アセットのロードはゲームスレッドでしかできない
+	TSharedPtr<FEvent, ESPMode::ThreadSafe> DoneEvent = MakeShareable(FPlatformProcess::GetSynchEventFromPool(true), [](FEvent* Event)
+	{
+		FPlatformProcess::ReturnSynchEventToPool(Event);
+	});
+	TWeakPtr<FBlueprintToDocServer, ESPMode::ThreadSafe> WeakThis = AsShared();
+
+	// レポートでは全てを抽出するので、エディタを止めないように時間の予算ごとのタスクに分ける
+	while(Batch->NextIndex < Indices.Num())
+	{
+		DoneEvent->Reset();
+		AsyncTask(ENamedThreads::GameThread, [WeakThis, Indices, DoneEvent, Batch]()
+		{
+			const UBlueprintToDocUserSettings* Settings = GetDefault<UBlueprintToDocUserSettings>();
+			const double TimeBudgetSeconds = Settings->ExtractionTimeBudgetMs / 1000.0;
+			const double StartTime = FPlatformTime::Seconds();
+
+			TSharedPtr<FBlueprintToDocServer, ESPMode::ThreadSafe> This = WeakThis.Pin();
+			int32 ProcessedCount = 0;
+			while(Batch->NextIndex < Indices.Num())
+			{
+				if(!This.IsValid() || This->bStopping)
+				{
+					Batch->NextIndex = Indices.Num();
+					break;
+				}
+				// 少なくとも1つは処理する
+				if(TimeBudgetSeconds > 0.0 && ProcessedCount > 0 && FPlatformTime::Seconds() - StartTime >= TimeBudgetSeconds)
+				{
+					break;
+				}
+				const int32 Index = Indices[Batch->NextIndex++];
+
+				FAssetData AssetData;
+				TSharedPtr<const FDocumentSymbolTable, ESPMode::ThreadSafe> Symbols;
+				{
+					FScopeLock Lock(&This->DocumentLock);
+					if(!This->Extracted.IsValidIndex(Index) || This->Extracted[Index])
+					{
+						continue;
+					}
+					AssetData = This->Assets[Index];
+					Symbols = This->Document.Symbols;
+				}
+				++ProcessedCount;
+
+				// ロード中はロックしない
+				FExtractResult Result;
+				Result.Index = Index;
+				Result.ObjectPath = AssetData.ObjectPath;
+				if(UBlueprintToDocUtil::MakeBlueprintSnapshot(Result.Snapshot, AssetData, *Symbols, *This->LoadCost, *This->MacroCost))
+				{
+					Batch->Results.Add(MoveTemp(Result));
+				}
+				else
+				{
+					// 抽出できなかったものは名前とパスだけのまま
+					FScopeLock Lock(&This->DocumentLock);
+					if(This->Assets.IsValidIndex(Index) && This->Assets[Index].ObjectPath == AssetData.ObjectPath)
+					{
+						This->Extracted[Index] = true;
+					}
+				}
+			}
+			DoneEvent->Trigger();
+		});
+
+		// 終了時にゲームスレッドを待ち続けないようにする
+		while(!DoneEvent->Wait(100))
+		{
+			if(bStopping)
+			{
+				return;
+			}
+		}
+
+		// 整形はこのスレッドで行い、その間にゲームスレッドを空ける
+		TArray<FExtractResult> Results = MoveTemp(Batch->Results);
+		for(const FExtractResult& Result : Results)
+		{
+			FBlueprintDocument BlueprintDocument;
+			UBlueprintToDocUtil::FormatBlueprintSnapshot(BlueprintDocument, Result.Snapshot);
+
+			FScopeLock Lock(&DocumentLock);
+			// 抽出中に作り直されていたら捨てる
+			if(Assets.IsValidIndex(Result.Index) && Assets[Result.Index].ObjectPath == Result.ObjectPath)
+			{
+				Document.Blueprints[Result.Index] = MoveTemp(BlueprintDocument);
+				Extracted[Result.Index] = true;
+			}
+		}
+	}
+}
+
+void FBlueprintToDocServer::ExtractType(int32 Index)
+{
+	TSharedPtr<FEvent, ESPMode::ThreadSafe> DoneEvent = MakeShareable(FPlatformProcess::GetSynchEventFromPool(true), [](FEvent* Event)
+	{
+		FPlatformProcess::ReturnSynchEventToPool(Event);
+	});
+	TWeakPtr<FBlueprintToDocServer, ESPMode::ThreadSafe> WeakThis = AsShared();
+
+	// 構造体、enumは小さいのでゲームスレッドで整形まで行う
+	AsyncTask(ENamedThreads::GameThread, [WeakThis, Index, DoneEvent]()
+	{
+		TSharedPtr<FBlueprintToDocServer, ESPMode::ThreadSafe> This = WeakThis.Pin();
+		if(This.IsValid() && !This->bStopping)
+		{
+			FAssetData AssetData;
+			TSharedPtr<const FDocumentSymbolTable, ESPMode::ThreadSafe> Symbols;
+			{
+				FScopeLock Lock(&This->DocumentLock);
+				if(This->TypeExtracted.IsValidIndex(Index) && !This->TypeExtracted[Index])
+				{
+					AssetData = This->TypeAssets[Index];
+					Symbols = This->Document.Symbols;
+				}
+			}
+
+			if(Symbols.IsValid())
+			{
+				// 抽出できなかったものは名前とパスだけのまま
+				FTypeDocument TypeDocument;
+				const bool bMade = UBlueprintToDocUtil::MakeTypeDocument(TypeDocument, AssetData, *Symbols);
+
+				FScopeLock Lock(&This->DocumentLock);
+				// 抽出中に作り直されていたら捨てる
+				if(This->TypeAssets.IsValidIndex(Index) && This->TypeAssets[Index].ObjectPath == AssetData.ObjectPath)
+				{
+					if(bMade)
+					{
+						This->Document.Types[Index] = MoveTemp(TypeDocument);
+					}
+					This->TypeExtracted[Index] = true;
+				}
+			}
+		}
+		DoneEvent->Trigger();
+	});
+
+	// 終了時にゲームスレッドを待ち続けないようにする
+	while(!DoneEvent->Wait(100))
+	{
+		if(bStopping)
+		{
+			return;
+		}
+	}
+}
+
+void FBlueprintToDocServer::HandlePackageSaved(const FString& PackageFileName, UObject* Outer)
+{
+	check(IsInGameThread());
+
+	if(Outer == nullptr)
+	{
+		return;
+	}
+	const FName PackageName = Outer->GetOutermost()->GetFName();
+
+	// 保存したアセットのページ名(ドキュメントに無いアセットは無視する)
+	FString PageName;
+	{
+		FScopeLock Lock(&DocumentLock);
+		const int32 Index = Assets.IndexOfByPredicate([PackageName](const FAssetData& AssetData) { return AssetData.PackageName == PackageName; });
+		const int32 TypeIndex = TypeAssets.IndexOfByPredicate([PackageName](const FAssetData& AssetData) { return AssetData.PackageName == PackageName; });
+		if(Index != INDEX_NONE)
+		{
+			// 次に開いたときに抽出し直す
+			const FBlueprintDocument& OldDocument = Document.Blueprints[Index];
+			FBlueprintDocument BlueprintDocument;
+			BlueprintDocument.Name = OldDocument.Name;
+			BlueprintDocument.PageName = OldDocument.PageName;
+			BlueprintDocument.ContentPath = OldDocument.ContentPath;
+			Document.Blueprints[Index] = MoveTemp(BlueprintDocument);
+			Extracted[Index] = false;
+			PageName = Document.Blueprints[Index].PageName;
+		}
+		else if(TypeIndex != INDEX_NONE)
+		{
+			const FTypeDocument& OldDocument = Document.Types[TypeIndex];
+			FTypeDocument TypeDocument;
+			TypeDocument.Name = OldDocument.Name;
+			TypeDocument.PageName = OldDocument.PageName;
+			TypeDocument.ContentPath = OldDocument.ContentPath;
+			Document.Types[TypeIndex] = MoveTemp(TypeDocument);
+			TypeExtracted[TypeIndex] = false;
+			PageName = Document.Types[TypeIndex].PageName;
+		}
+		else
+		{
+			return;
+		}
+		// 描画中のページは古い内容かもしれないのでキャッシュしない
+		DocumentGeneration.Increment();
+	}
+
+	// サイズとマクロの展開したノード数はこのアセットの分が変わる
+	ResetLoadCost();
+
+	// このアセットのページ(グラフのページを含む)とレポートだけ破棄する
+	TArray<FString> ReportPageNames;
+	UBlueprintToDocUtil::GetReportPageNames(ReportPageNames);
+	const FString GraphPagePrefix = PageName + TEXT(".");
+
+	FScopeLock Lock(&CacheLock);
+	TArray<FString> CachedPageNames;
+	PageCache.GetKeys(CachedPageNames);
+	for(const FString& CachedPageName : CachedPageNames)
+	{
+		if(CachedPageName.StartsWith(GraphPagePrefix) || ReportPageNames.Contains(CachedPageName))
+		{
+			PageCache.Remove(CachedPageName);
+		}
+	}
+}
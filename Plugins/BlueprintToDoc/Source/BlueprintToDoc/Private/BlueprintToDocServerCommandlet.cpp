@@ -0,0 +1,47 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "BlueprintToDocServerCommandlet.h"
+#include "BlueprintToDoc.h"
+#include "BlueprintToDocServer.h"
+#include "BlueprintToDocUserSettings.h"
+
+#include "AssetRegistryModule.h"
+#include "Async/TaskGraphInterfaces.h"
+
+
+UBlueprintToDocServerCommandlet::UBlueprintToDocServerCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = true;
+	LogToConsole = true;
+}
+
+int32 UBlueprintToDocServerCommandlet::Main(const FString& Params)
+{
+	const UBlueprintToDocUserSettings* Settings = GetDefault<UBlueprintToDocUserSettings>();
+	check(Settings);
+
+	int32 Port = Settings->DocServerPort;
+	FParse::Value(*Params, TEXT("Port="), Port);
+
+	// コマンドレットではアセットの一覧が作られていない
+	FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(FName("AssetRegistry"));
+	AssetRegistryModule.Get().SearchAllAssets(true);
+
+	TSharedRef<FBlueprintToDocServer, ESPMode::ThreadSafe> Server = MakeShared<FBlueprintToDocServer, ESPMode::ThreadSafe>(Port, Settings->DocServerCachedPageCount);
+	if(!Server->Start())
+	{
+		return 1;
+	}
+
+	// 抽出はゲームスレッドのタスクで届くので終了するまで処理し続ける
+	while(!GIsRequestingExit)
+	{
+		FTaskGraphInterface::Get().ProcessThreadUntilIdle(ENamedThreads::GameThread);
+		FPlatformProcess::Sleep(0.01f);
+	}
+
+	Server->Stop();
+	return 0;
+}
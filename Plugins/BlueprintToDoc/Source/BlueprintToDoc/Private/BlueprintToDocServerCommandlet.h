@@ -0,0 +1,22 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "BlueprintToDocServerCommandlet.generated.h"
+
+/**
+ * エディタを開かずにドキュメントサーバを起動する
+ * UE4Editor-Cmd.exe <Project> -run=BlueprintToDocServer [-Port=8080]
+ */
+UCLASS()
+class UBlueprintToDocServerCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UBlueprintToDocServerCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
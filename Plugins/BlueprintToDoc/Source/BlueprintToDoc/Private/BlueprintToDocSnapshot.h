@@ -0,0 +1,75 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BlueprintToDocUtil.h"
+
+/**
+ * ゲームスレッドでUObjectから写し取った加工前の情報
+ * 文字列の加工、カテゴリの整形、ソートはワーカースレッドで FormatBlueprintSnapshot が行う
+ */
+
+// ピン
+struct FEdGraphPinSnapshot
+{
+	FName Name;
+	FName PinCategory;
+	// PinSubCategoryObject の名前とパス(無ければNAME_None)
+	FName SubCategoryObjectName;
+	FName SubCategoryObjectPath;
+	// GetDefaultAsString の元になる値
+	FString DefaultObjectPath;
+	FText DefaultTextValue;
+	FString DefaultValue;
+	FString ToolTip;
+};
+
+// グラフ
+struct FEdGraphSnapshot
+{
+	// GraphName、Parent、Flag、実行コストは取得済み
+	FEdGraphDocument Document;
+
+	// 関数がある場合はメタデータ、無い場合はスキーマの表示情報
+	bool bHasFunction = false;
+	FString DisplayNameMetaData;
+	FString CategoryMetaData;
+	FString ToolTipMetaData;
+	FText DisplayName;
+	FText DisplayToolTip;
+	// FunctionEntry のコメント
+	FString EntryComment;
+	// 全てのノードとコメントボックスのコメント(TODOの抽出用)
+	TArray<FString> NodeComments;
+
+	TArray<FEdGraphPinSnapshot> InputPins;
+	TArray<FEdGraphPinSnapshot> OutputPins;
+};
+
+// プロパティ
+struct FPropertySnapshot
+{
+	// 名前、型、カテゴリ以外は取得済み(型のパスは取得済み)
+	FPropertyDocument Document;
+
+	FName Name;
+	FName TypeName;
+	// プロパティのクラス名なので "Property" を取り除く
+	bool bIsPropertyClassName = false;
+	FString CategoryMetaData;
+};
+
+// ブループリント
+struct FBlueprintSnapshot
+{
+	// グラフとプロパティ以外は取得済み
+	FBlueprintDocument Document;
+
+	TArray<FEdGraphSnapshot> Events;
+	TArray<FEdGraphSnapshot> Macros;
+	TArray<FEdGraphSnapshot> Functions;
+	TArray<FPropertySnapshot> Properties;
+	// 抽出時の設定のTODOの目印
+	TArray<FString> TodoMarkers;
+};
@@ -3,19 +3,65 @@
 #include "BlueprintToDocUtil.h"
 #include "BlueprintToDoc.h"
 #include "BlueprintToDocUserSettings.h"
+#include "BlueprintToDocBinaryWriter.h"
+#include "BlueprintToDocDatabase.h"
+#include "BlueprintToDocFlagLabels.h"
+#include "BlueprintToDocGraphSVG.h"
+#include "BlueprintToDocHTMLWriter.h"
+#include "BlueprintToDocJob.h"
+#include "BlueprintToDocLoadCost.h"
+#include "BlueprintToDocMacroCost.h"
+#include "BlueprintToDocPropertyTable.h"
+#include "BlueprintToDocSnapshot.h"
 
 #include "AssetRegistryModule.h"
 #include "GenericPlatformFile.h"
 #include "PlatformFilemanager.h"
 #include "Paths.h"
 #include "FileHelper.h"
+#include "Misc/PackageName.h"
 
 #include "Engine/Blueprint.h"
+#include "Engine/BlueprintGeneratedClass.h"
+#include "Engine/InheritableComponentHandler.h"
+#include "Engine/SCS_Node.h"
+#include "Engine/SimpleConstructionScript.h"
+#include "Engine/UserDefinedEnum.h"
+#include "Engine/UserDefinedStruct.h"
 #include "EdGraph/EdGraph.h"
+#include "EdGraphNode_Comment.h"
 #include "CoreNet.h"
+#include "Animation/AnimBlueprint.h"
+#include "Blueprint/UserWidget.h"
+#include "Blueprint/WidgetTree.h"
+#include "Components/InvalidationBox.h"
+#include "Components/PanelWidget.h"
+#include "Components/RetainerBox.h"
+#include "WidgetBlueprint.h"
 #include "Animation/PreviewAssetAttachComponent.h"
 #include "Class.h"
+#include "Components/PrimitiveComponent.h"
+#include "UObject/EnumProperty.h"
+#include "GameFramework/Actor.h"
+#include "Templates/AlignmentTemplates.h"
 #include <EdGraphSchema_K2.h>
+#include "K2Node_CallFunction.h"
+#include "K2Node_Composite.h"
+#include "K2Node_DynamicCast.h"
+#include "K2Node_Event.h"
+#include "K2Node_FunctionEntry.h"
+#include "K2Node_FunctionResult.h"
+#include "K2Node_MacroInstance.h"
+#include "K2Node_BreakStruct.h"
+#include "K2Node_VariableGet.h"
+#include "Kismet/KismetMathLibrary.h"
+#include "AnimationGraph.h"
+#include "AnimationGraphSchema.h"
+#include "AnimationStateMachineGraph.h"
+#include "AnimGraphNode_Base.h"
+#include "AnimGraphNode_StateMachineBase.h"
+#include "AnimStateNodeBase.h"
+#include "AnimStateTransitionNode.h"
 
 #include "Tests/AutomationCommon.h"
 #include "Misc/AutomationTest.h"
@@ -24,25 +70,462 @@
 // ソート用
 struct FBlueprintSorter
 {
-	bool operator()(FBlueprintDocument A, FBlueprintDocument B) const
+	bool operator()(const FBlueprintDocument& A, const FBlueprintDocument& B) const
 	{
 		return A.ContentPath < B.ContentPath;
 	}
 };
 struct FGraphSorter
 {
-	bool operator()(FEdGraphDocument A, FEdGraphDocument B) const
+	bool operator()(const FEdGraphDocument& A, const FEdGraphDocument& B) const
 	{
-		return A.Category < B.Category;
+		return UBlueprintToDocUtil::NameLess(A.Category, B.Category);
 	}
 };
 struct FPropertySorter
 {
-	bool operator()(FPropertyDocument A, FPropertyDocument B) const
+	bool operator()(const FPropertyDocument& A, const FPropertyDocument& B) const
 	{
-		return A.Category < B.Category;
+		return UBlueprintToDocUtil::NameLess(A.Category, B.Category);
 	}
 };
+struct FReplicationSorter
+{
+	bool operator()(const FBlueprintDocument& A, const FBlueprintDocument& B) const
+	{
+		return A.ReplicatedSize > B.ReplicatedSize;
+	}
+};
+struct FHardReferenceSorter
+{
+	bool operator()(const FBlueprintDocument& A, const FBlueprintDocument& B) const
+	{
+		return A.HardReferenceMemorySize > B.HardReferenceMemorySize;
+	}
+};
+
+// ホットスポットのスコア
+static int32 GetHotspotScore(const FEdGraphDocument& EdGraph)
+{
+	return EdGraph.HotNodeCount
+		+ EdGraph.PureReevaluationCount
+		+ EdGraph.HotLoopCount * 10
+		+ EdGraph.HotCastCount * 5
+		+ EdGraph.HotActorSearchCount * 50;
+}
+
+// ピュアノードか
+static bool IsPureNode(const UEdGraphNode* Node)
+{
+	const UK2Node* K2Node = Cast<const UK2Node>(Node);
+	return (K2Node != nullptr) && K2Node->IsNodePure();
+}
+
+// ピュアノードを評価する実行ノードの数(ピュアノードを経由する分も含む)
+static int32 CountPureConsumers(UEdGraphNode* Node, TMap<UEdGraphNode*, int32>& Memo)
+{
+	if(const int32* Count = Memo.Find(Node))
+	{
+		return *Count;
+	}
+	// 循環対策
+	Memo.Add(Node, 0);
+
+	int32 Count = 0;
+	for(UEdGraphPin* Pin : Node->Pins)
+	{
+		if(Pin->Direction != EGPD_Output)
+		{
+			continue;
+		}
+		for(UEdGraphPin* LinkedPin : Pin->LinkedTo)
+		{
+			UEdGraphNode* LinkedNode = LinkedPin->GetOwningNode();
+			Count += IsPureNode(LinkedNode) ? CountPureConsumers(LinkedNode, Memo) : 1;
+		}
+	}
+	Memo.Add(Node, Count);
+	return Count;
+}
+
+// ループのマクロか(エンジンのStandardMacrosのループと、それを使うマクロ)
+static bool IsLoopMacro(const UEdGraph* MacroGraph, TSet<const UEdGraph*>& VisitedGraphs)
+{
+	static const FName StandardMacrosPath(TEXT("/Engine/EditorBlueprintResources/StandardMacros"));
+	static const TSet<FName> StandardLoopMacroNames = {
+		TEXT("ForLoop"),
+		TEXT("ForLoopWithBreak"),
+		TEXT("ForEachLoop"),
+		TEXT("ForEachLoopWithBreak"),
+		TEXT("ReverseForEachLoop"),
+		TEXT("WhileLoop"),
+	};
+
+	if(MacroGraph == nullptr)
+	{
+		return false;
+	}
+	bool bAlreadyInSet = false;
+	VisitedGraphs.Add(MacroGraph, &bAlreadyInSet);
+	if(bAlreadyInSet)
+	{
+		return false;
+	}
+
+	if(MacroGraph->GetOutermost()->GetFName() == StandardMacrosPath)
+	{
+		return StandardLoopMacroNames.Contains(MacroGraph->GetFName());
+	}
+	for(const UEdGraphNode* Node : MacroGraph->Nodes)
+	{
+		const UK2Node_MacroInstance* MacroInstance = Cast<const UK2Node_MacroInstance>(Node);
+		if(MacroInstance != nullptr && IsLoopMacro(MacroInstance->GetMacroGraph(), VisitedGraphs))
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+// プロパティの型名と型のオブジェクトパスを取得する(型名がプロパティのクラス名の場合はtrue)
+static bool GetPropertyType(const UProperty* Property, FName& OutTypeName, FName& OutTypePath)
+{
+	const UObject* TypeObject = nullptr;
+	if(const UStructProperty* StructProperty = Cast<const UStructProperty>(Property))
+	{
+		TypeObject = StructProperty->Struct;
+	}
+	else if(const UObjectProperty* ObjectProperty = Cast<const UObjectProperty>(Property))
+	{
+		TypeObject = ObjectProperty->PropertyClass;
+	}
+	else if(const UEnumProperty* EnumProperty = Cast<const UEnumProperty>(Property))
+	{
+		TypeObject = EnumProperty->GetEnum();
+	}
+	else if(const UByteProperty* ByteProperty = Cast<const UByteProperty>(Property))
+	{
+		TypeObject = ByteProperty->Enum;
+	}
+
+	if(TypeObject == nullptr)
+	{
+		OutTypeName = Property->GetClass()->GetFName();
+		OutTypePath = NAME_None;
+		return true;
+	}
+	OutTypeName = TypeObject->GetFName();
+	OutTypePath = FName(*TypeObject->GetPathName());
+	return false;
+}
+
+// プロパティのクラス名から "Property" を取り除く
+static FName TrimPropertyClassName(FName TypeName)
+{
+	return FName(*TypeName.ToString().Replace(TEXT("Property"), TEXT("")));
+}
+
+// SCSのノードと子ノードを深さ優先で追加する
+static void AddComponentDocuments(TArray<FComponentDocument>& OutComponentDocuments, const USCS_Node* Node, FName ParentName, int32 Depth, bool bInherited, const TMap<const USCS_Node*, const UActorComponent*>& OverriddenTemplates)
+{
+	FComponentDocument& ComponentDocument = OutComponentDocuments.AddDefaulted_GetRef();
+	ComponentDocument.Name = Node->GetVariableName().ToString();
+	ComponentDocument.Depth = Depth;
+	ComponentDocument.bInherited = bInherited;
+	// SCSのルートはネイティブか親クラスのコンポーネントにアタッチされる
+	ComponentDocument.AttachParent = ParentName.IsNone() ? Node->ParentComponentOrVariableName : ParentName;
+	ComponentDocument.AttachSocket = Node->AttachToName;
+
+	// 子クラスで上書きされていればそのテンプレートを使う
+	const UActorComponent* Template = OverriddenTemplates.FindRef(Node);
+	if(Template == nullptr)
+	{
+		Template = Node->ComponentTemplate;
+	}
+
+	const UClass* ComponentClass = (Template != nullptr) ? Template->GetClass() : Node->ComponentClass;
+	if(ComponentClass != nullptr)
+	{
+		ComponentDocument.ComponentClass = ComponentClass->GetFName();
+		ComponentDocument.ClassPath = FName(*ComponentClass->GetPathName());
+	}
+
+	if(Template != nullptr)
+	{
+		ComponentDocument.bCanEverTick = Template->PrimaryComponentTick.bCanEverTick;
+		ComponentDocument.bStartWithTickEnabled = Template->PrimaryComponentTick.bStartWithTickEnabled;
+		ComponentDocument.TickInterval = Template->PrimaryComponentTick.TickInterval;
+
+		if(const UPrimitiveComponent* PrimitiveComponent = Cast<const UPrimitiveComponent>(Template))
+		{
+			ComponentDocument.bIsPrimitive = true;
+			ComponentDocument.CollisionProfile = PrimitiveComponent->GetCollisionProfileName();
+			ComponentDocument.CollisionEnabled = PrimitiveComponent->GetCollisionEnabled();
+			ComponentDocument.bGenerateOverlapEvents = PrimitiveComponent->GetGenerateOverlapEvents();
+		}
+	}
+
+	for(const USCS_Node* ChildNode : Node->GetChildNodes())
+	{
+		AddComponentDocuments(OutComponentDocuments, ChildNode, Node->GetVariableName(), Depth + 1, bInherited, OverriddenTemplates);
+	}
+}
+
+// コリジョンの有効状態の表示名
+static const ANSICHAR* GetCollisionEnabledLabel(ECollisionEnabled::Type CollisionEnabled)
+{
+	switch(CollisionEnabled)
+	{
+	case ECollisionEnabled::NoCollision:		return "NoCollision";
+	case ECollisionEnabled::QueryOnly:			return "QueryOnly";
+	case ECollisionEnabled::PhysicsOnly:		return "PhysicsOnly";
+	case ECollisionEnabled::QueryAndPhysics:	return "QueryAndPhysics";
+	default:									return "";
+	}
+}
+
+// 目印の位置(前後が英数字に続くものは除く)
+static int32 FindTodoMarker(const FString& Text, const FString& Marker)
+{
+	int32 SearchFrom = 0;
+	for(;;)
+	{
+		const int32 Position = Text.Find(Marker, ESearchCase::CaseSensitive, ESearchDir::FromStart, SearchFrom);
+		if(Position == INDEX_NONE)
+		{
+			return INDEX_NONE;
+		}
+		const int32 End = Position + Marker.Len();
+		const bool bWordStart = (Position == 0) || !FChar::IsAlnum(Text[Position - 1]);
+		const bool bWordEnd = (End >= Text.Len()) || !FChar::IsAlnum(Text[End]);
+		if(bWordStart && bWordEnd)
+		{
+			return Position;
+		}
+		SearchFrom = Position + 1;
+	}
+}
+
+// コメントの各行から目印以降を集める
+static void FindTodoLines(TArray<FString>& OutTodoList, const FString& Comment, const TArray<FString>& TodoMarkers)
+{
+	TArray<FString> Lines;
+	Comment.ParseIntoArrayLines(Lines);
+	for(const FString& Line : Lines)
+	{
+		for(const FString& Marker : TodoMarkers)
+		{
+			const int32 Position = Marker.IsEmpty() ? INDEX_NONE : FindTodoMarker(Line, Marker);
+			if(Position != INDEX_NONE)
+			{
+				OutTodoList.Add(Line.Mid(Position).TrimEnd());
+				break;
+			}
+		}
+	}
+}
+
+// ピンの接続元がプロパティアクセスの高速パスで読めるか(メンバー変数、構造体のメンバー、boolの否定)
+static bool IsAnimFastPathSource(const UEdGraphPin* SourcePin)
+{
+	const UEdGraphNode* SourceNode = SourcePin->GetOwningNode();
+	if(const UK2Node_VariableGet* VariableGet = Cast<const UK2Node_VariableGet>(SourceNode))
+	{
+		// 他のオブジェクトの変数は関数呼び出しと同じくブループリントVMで評価される
+		const UEdGraphPin* SelfPin = VariableGet->FindPin(UEdGraphSchema_K2::PN_Self);
+		return SelfPin == nullptr || SelfPin->LinkedTo.Num() == 0;
+	}
+
+	// 構造体の分解とboolの否定は、その入力が高速パスで読めれば良い
+	const UK2Node_CallFunction* CallFunction = Cast<const UK2Node_CallFunction>(SourceNode);
+	const bool bIsNot = (CallFunction != nullptr) && (CallFunction->FunctionReference.GetMemberName() == GET_FUNCTION_NAME_CHECKED(UKismetMathLibrary, Not_PreBool));
+	if(bIsNot || SourceNode->IsA<UK2Node_BreakStruct>())
+	{
+		for(const UEdGraphPin* Pin : SourceNode->Pins)
+		{
+			if(Pin->Direction == EGPD_Input && !Pin->bHidden)
+			{
+				return Pin->LinkedTo.Num() == 1 && IsAnimFastPathSource(Pin->LinkedTo[0]);
+			}
+		}
+	}
+	return false;
+}
+
+// 関数がワーカースレッドから呼べるか(関数かクラスにBlueprintThreadSafeのメタデータがある)
+static bool IsThreadSafeFunction(const UFunction* Function)
+{
+	return Function->HasMetaData(TEXT("BlueprintThreadSafe")) || Function->GetOwnerClass()->HasMetaData(TEXT("BlueprintThreadSafe"));
+}
+
+// 入力の接続元を辿ってスレッドセーフでない関数の呼び出しを集める
+static void FindThreadUnsafeCalls(TArray<FString>& OutCalls, const UEdGraphNode* Node, TSet<const UEdGraphNode*>& VisitedNodes)
+{
+	for(const UEdGraphPin* Pin : Node->Pins)
+	{
+		if(Pin->Direction != EGPD_Input || UAnimationGraphSchema::IsPosePin(Pin->PinType))
+		{
+			continue;
+		}
+		for(const UEdGraphPin* LinkedPin : Pin->LinkedTo)
+		{
+			const UEdGraphNode* SourceNode = LinkedPin->GetOwningNode();
+			bool bIsAlreadyVisited = false;
+			VisitedNodes.Add(SourceNode, &bIsAlreadyVisited);
+			if(bIsAlreadyVisited)
+			{
+				continue;
+			}
+
+			if(const UK2Node_CallFunction* CallFunction = Cast<const UK2Node_CallFunction>(SourceNode))
+			{
+				const UFunction* Function = CallFunction->GetTargetFunction();
+				if(Function != nullptr && !IsThreadSafeFunction(Function))
+				{
+					OutCalls.AddUnique(Function->GetName());
+				}
+			}
+			FindThreadUnsafeCalls(OutCalls, SourceNode, VisitedNodes);
+		}
+	}
+}
+
+// アニメーショングラフのノードを追加する(ステートマシンはステートと遷移のグラフも辿る)
+static void AddAnimNodeDocuments(FBlueprintDocument& OutBlueprintDocument, const UEdGraph* EdGraph, const FString& GraphPath)
+{
+	for(const UEdGraphNode* Node : EdGraph->Nodes)
+	{
+		const UAnimGraphNode_Base* AnimNode = Cast<const UAnimGraphNode_Base>(Node);
+		if(AnimNode == nullptr)
+		{
+			continue;
+		}
+
+		FAnimNodeDocument& AnimNodeDocument = OutBlueprintDocument.AnimNodes.AddDefaulted_GetRef();
+		AnimNodeDocument.Title = AnimNode->GetNodeTitle(ENodeTitleType::ListView).ToString();
+		AnimNodeDocument.GraphPath = GraphPath;
+		for(const UEdGraphPin* Pin : AnimNode->Pins)
+		{
+			if(Pin->Direction != EGPD_Input || Pin->LinkedTo.Num() == 0 || UAnimationGraphSchema::IsPosePin(Pin->PinType))
+			{
+				continue;
+			}
+			AnimNodeDocument.BoundPinCount++;
+			if(!IsAnimFastPathSource(Pin->LinkedTo[0]))
+			{
+				AnimNodeDocument.SlowPathPinCount++;
+			}
+		}
+		TSet<const UEdGraphNode*> VisitedNodes;
+		FindThreadUnsafeCalls(AnimNodeDocument.ThreadUnsafeCalls, AnimNode, VisitedNodes);
+
+		// ステートマシン
+		const UAnimGraphNode_StateMachineBase* StateMachineNode = Cast<const UAnimGraphNode_StateMachineBase>(AnimNode);
+		if(StateMachineNode == nullptr || StateMachineNode->EditorStateMachineGraph == nullptr)
+		{
+			continue;
+		}
+		const FString StateMachinePath = GraphPath / StateMachineNode->GetStateMachineName();
+		const UEdGraph* StateMachineGraph = StateMachineNode->EditorStateMachineGraph;
+
+		TMap<const UAnimStateNodeBase*, int32> StateIndices;
+		for(const UEdGraphNode* StateMachineGraphNode : StateMachineGraph->Nodes)
+		{
+			const UAnimStateNodeBase* StateNode = Cast<const UAnimStateNodeBase>(StateMachineGraphNode);
+			if(StateNode == nullptr || StateNode->GetBoundGraph() == nullptr)
+			{
+				continue;
+			}
+
+			const int32 FirstNodeIndex = OutBlueprintDocument.AnimNodes.Num();
+			AddAnimNodeDocuments(OutBlueprintDocument, StateNode->GetBoundGraph(), StateMachinePath / StateNode->GetStateName());
+
+			// 遷移のルールはステートとして数えない
+			if(StateNode->IsA<UAnimStateTransitionNode>())
+			{
+				continue;
+			}
+
+			StateIndices.Add(StateNode, OutBlueprintDocument.AnimStates.Num());
+			FAnimStateDocument& AnimStateDocument = OutBlueprintDocument.AnimStates.AddDefaulted_GetRef();
+			AnimStateDocument.StateMachine = StateMachinePath;
+			AnimStateDocument.Name = StateNode->GetStateName();
+			AnimStateDocument.NodeCount = OutBlueprintDocument.AnimNodes.Num() - FirstNodeIndex;
+			for(int32 NodeIndex = FirstNodeIndex; NodeIndex < OutBlueprintDocument.AnimNodes.Num(); ++NodeIndex)
+			{
+				if(OutBlueprintDocument.AnimNodes[NodeIndex].SlowPathPinCount > 0)
+				{
+					AnimStateDocument.SlowPathNodeCount++;
+				}
+			}
+		}
+
+		// 遷移は遷移元のステートで数える
+		for(const UEdGraphNode* StateMachineGraphNode : StateMachineGraph->Nodes)
+		{
+			if(const UAnimStateTransitionNode* TransitionNode = Cast<const UAnimStateTransitionNode>(StateMachineGraphNode))
+			{
+				if(const int32* StateIndex = StateIndices.Find(TransitionNode->GetPreviousState()))
+				{
+					OutBlueprintDocument.AnimStates[*StateIndex].TransitionCount++;
+				}
+			}
+		}
+	}
+}
+
+// Tickをブループリントで実装しているか(UUserWidget::Tickはネイティブの実装が無いイベント)
+static bool HasBlueprintTick(const UClass* Class)
+{
+	const UFunction* Function = Class->FindFunctionByName(GET_FUNCTION_NAME_CHECKED(UUserWidget, Tick));
+	return Function != nullptr && Cast<const UBlueprintGeneratedClass>(Function->GetOuter()) != nullptr;
+}
+
+// グラフと折りたたんだグラフのマクロのインスタンスを数える
+static void AddMacroUsages(TArray<FMacroUsageDocument>& OutMacroUsages, TMap<const UEdGraph*, int32>& UsageIndices, const UEdGraph* EdGraph, FBlueprintToDocMacroCost& MacroCost)
+{
+	for(const UEdGraphNode* Node : EdGraph->Nodes)
+	{
+		const UK2Node_MacroInstance* MacroInstance = Cast<const UK2Node_MacroInstance>(Node);
+		const UEdGraph* MacroGraph = (MacroInstance != nullptr) ? MacroInstance->GetMacroGraph() : nullptr;
+		if(MacroGraph == nullptr)
+		{
+			continue;
+		}
+
+		if(const int32* UsageIndex = UsageIndices.Find(MacroGraph))
+		{
+			OutMacroUsages[*UsageIndex].InstanceCount++;
+			continue;
+		}
+		UsageIndices.Add(MacroGraph, OutMacroUsages.Num());
+		FMacroUsageDocument& MacroUsage = OutMacroUsages.AddDefaulted_GetRef();
+		MacroUsage.Name = MacroGraph->GetName();
+		MacroUsage.MacroPath = FName(*MacroGraph->GetPathName());
+		if(const UBlueprint* Library = MacroGraph->GetTypedOuter<UBlueprint>())
+		{
+			MacroUsage.Library = Library->GetFName();
+			MacroUsage.LibraryPath = FName(*Library->GetPathName());
+		}
+		MacroUsage.InstanceCount = 1;
+		MacroUsage.ExpandedNodeCount = MacroCost.GetExpandedNodeCount(MacroGraph);
+	}
+
+	for(const UEdGraph* SubGraph : EdGraph->SubGraphs)
+	{
+		AddMacroUsages(OutMacroUsages, UsageIndices, SubGraph, MacroCost);
+	}
+}
+
+// メタデータのカテゴリを表示用のFNameにする
+static FName MakeCategoryName(const FString& CategoryMetaData)
+{
+	if(CategoryMetaData.IsEmpty())
+	{
+		return NAME_None;
+	}
+	return FName(*CategoryMetaData.Replace(TEXT("|"), TEXT(" - ")));
+}
 
 
 /**
@@ -78,9 +561,6 @@ bool FBlueprintToDocTest::RunTest(const FString& Parameters)
 	return true;
 }
 
-// ドキュメントテンプレート
-static const TCHAR HTMLTemplate[] = TEXT("<!DOCTYPE html><html><head><meta charset=\"utf-8\"><title></title><link href=\"../layout.css\" rel=\"stylesheet\" type=\"text/css\"></head><body>\n%s\n</body></html>");
-
 
 void UBlueprintToDocUtil::BlueprintToDoc()
 {
@@ -101,13 +581,111 @@ void UBlueprintToDocUtil::BlueprintToDoc()
 	}
 	FPaths::NormalizeDirectoryName(Document.RootPath);
 
-	BlueprintToDoc_Exec(Document);
+	// ドライランはジョブの中で選択されるアセットを数えるだけになる
+	const FString ResultMessage = BlueprintToDoc_Exec(Document);
 
 	// 終了を通知
-	FPlatformMisc::MessageBoxExt(EAppMsgType::Ok, TEXT("Finish！！ BlueprintToDoc"), TEXT("BlueprintToDoc"));
+	FPlatformMisc::MessageBoxExt(EAppMsgType::Ok, *ResultMessage, TEXT("BlueprintToDoc"));
+}
+
+FString UBlueprintToDocUtil::BlueprintToDoc_Exec(FDocument& Document)
+{
+	// 時間の制限なしで最後まで実行する
+	FBlueprintToDocJob Job(Document.RootPath, 0.0f);
+	if(Job.Start())
+	{
+		Job.RunToCompletion();
+		Document = Job.GetDocument();
+	}
+	return Job.GetResultMessage();
+}
+
+FString UBlueprintToDocUtil::NameToString(FName Name)
+{
+	return Name.IsNone() ? FString() : Name.ToString();
+}
+
+const FDocumentSymbolTable& FDocument::GetSymbols() const
+{
+	static const FDocumentSymbolTable EmptySymbols;
+	return Symbols.IsValid() ? *Symbols : EmptySymbols;
+}
+
+bool UBlueprintToDocUtil::NameLess(FName A, FName B)
+{
+	// 同じ名前はインデックスの比較だけで済む
+	if(A == B)
+	{
+		return false;
+	}
+	if(A.IsNone() || B.IsNone())
+	{
+		return A.IsNone();
+	}
+	return A.Compare(B) < 0;
+}
+
+void UBlueprintToDocUtil::ExportData(const FDocument& Document)
+{
+	const UBlueprintToDocUserSettings* Settings = GetDefault<UBlueprintToDocUserSettings>();
+
+	// プロパティ一覧
+	if(Settings->bExportPropertyTable)
+	{
+		FBlueprintToDocPropertyTable PropertyTable;
+		PropertyTable.Build(Document);
+		PropertyTable.ExportCSV(Document.RootPath / "data" / "properties.csv.gz");
+		PropertyTable.ExportColumnar(Document.RootPath / "data" / "properties.bcol");
+	}
+
+	// データベース
+	if(Settings->bExportDatabase)
+	{
+		FBlueprintToDocDatabase::Export(Document, Document.RootPath / "data" / "blueprints.db");
+	}
+
+	// バイナリ
+	if(Settings->bExportBinary)
+	{
+		FBlueprintToDocBinaryWriter::Export(Document, Document.RootPath / "data" / "blueprints.bpdb");
+	}
+}
+
+
+// パターンのどれかに一致するか
+static bool MatchesAnyPattern(const FString& Value, const TArray<FString>& Patterns)
+{
+	for(const FString& Pattern : Patterns)
+	{
+		if(Value.MatchesWildcard(Pattern))
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+// タグの値がパターンに一致するか(タグが無ければ一致しない)
+static bool MatchesTagValue(const FAssetData& AssetData, FName Tag, const FString& Pattern)
+{
+	FString Value;
+	return AssetData.GetTagValue(Tag, Value) && Value.MatchesWildcard(Pattern);
+}
+
+// ブループリントの生成クラス名をタグから取得する(ブループリントでなければNAME_None)
+static FName GetGeneratedClassName(const FAssetData& AssetData)
+{
+	FString GeneratedClassPath;
+	if(!AssetData.GetTagValue(FBlueprintTags::GeneratedClassPath, GeneratedClassPath))
+	{
+		return NAME_None;
+	}
+	return FName(*FPackageName::ObjectPathToObjectName(FPackageName::ExportTextPathToObjectPath(GeneratedClassPath)));
 }
 
-void UBlueprintToDocUtil::BlueprintToDoc_Exec(FDocument& Document)
+// 設定されたパス以下のアセットを取得し、設定の条件で選択する(アセットはロードしない)
+// 親クラスとタグの条件はブループリント向けなので、bBlueprintFilters が無効なら調べない
+static bool GetProjectAssets(TArray<FAssetData>& OutAssetData, std::initializer_list<const UClass*> Classes, bool bBlueprintFilters)
 {
 	const UBlueprintToDocUserSettings* Settings = GetDefault<UBlueprintToDocUserSettings>();
 
@@ -115,636 +693,2498 @@ void UBlueprintToDocUtil::BlueprintToDoc_Exec(FDocument& Document)
 	FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(FName("AssetRegistry"));
 	IAssetRegistry& AssetRegistry = AssetRegistryModule.Get();
 
-	// 探すアセットのフィルタ
-	FARFilter Filter;
-	Filter.bRecursivePaths = true;
-	Filter.PackagePaths.Append(Settings->ContentPaths);
-	Filter.bIncludeOnlyOnDiskAssets = false;
-	Filter.ClassNames.Add(UBlueprint::StaticClass()->GetFName());
-	Filter.bRecursiveClasses = true;
+	// 探すアセットのフィルタ
+	FARFilter Filter;
+	Filter.bRecursivePaths = true;
+	Filter.PackagePaths.Append(Settings->ContentPaths);
+	Filter.bIncludeOnlyOnDiskAssets = false;
+	for(const UClass* Class : Classes)
+	{
+		Filter.ClassNames.Add(Class->GetFName());
+	}
+	Filter.bRecursiveClasses = true;
+
+	if(!AssetRegistry.GetAssets(Filter, OutAssetData))
+	{
+		return false;
+	}
+
+	// 親クラスはアセットレジストリのクラス階層から派生クラス名に展開しておく
+	TSet<FName> IncludedClassNames;
+	TSet<FName> ExcludedClassNames;
+	if(Settings->IncludeParentClasses.Num() > 0)
+	{
+		AssetRegistry.GetDerivedClassNames(Settings->IncludeParentClasses, TSet<FName>(), IncludedClassNames);
+	}
+	if(Settings->ExcludeParentClasses.Num() > 0)
+	{
+		AssetRegistry.GetDerivedClassNames(Settings->ExcludeParentClasses, TSet<FName>(), ExcludedClassNames);
+	}
+
+	const int32 FoundCount = OutAssetData.Num();
+	int32 PathExcludedCount = 0;
+	int32 ParentClassExcludedCount = 0;
+	int32 TagExcludedCount = 0;
+	OutAssetData.RemoveAll([&](const FAssetData& AssetData)
+	{
+		// パス
+		const FString PackageName = AssetData.PackageName.ToString();
+		if((Settings->IncludePathPatterns.Num() > 0 && !MatchesAnyPattern(PackageName, Settings->IncludePathPatterns))
+			|| MatchesAnyPattern(PackageName, Settings->ExcludePathPatterns))
+		{
+			++PathExcludedCount;
+			return true;
+		}
+
+		// ブループリント以外(構造体、enum)はリンク先が無くならないようにパスだけで選択する
+		if(!bBlueprintFilters)
+		{
+			return false;
+		}
+
+		// 親クラス
+		const FName GeneratedClassName = GetGeneratedClassName(AssetData);
+		if(!GeneratedClassName.IsNone()
+			&& ((Settings->IncludeParentClasses.Num() > 0 && !IncludedClassNames.Contains(GeneratedClassName))
+				|| ExcludedClassNames.Contains(GeneratedClassName)))
+		{
+			++ParentClassExcludedCount;
+			return true;
+		}
+
+		// タグ
+		for(const TPair<FName, FString>& TagValue : Settings->RequiredTagValues)
+		{
+			if(!MatchesTagValue(AssetData, TagValue.Key, TagValue.Value))
+			{
+				++TagExcludedCount;
+				return true;
+			}
+		}
+		for(const TPair<FName, FString>& TagValue : Settings->ExcludedTagValues)
+		{
+			if(MatchesTagValue(AssetData, TagValue.Key, TagValue.Value))
+			{
+				++TagExcludedCount;
+				return true;
+			}
+		}
+		return false;
+	});
+
+	UE_LOG(LogBlueprintToDoc, Log, TEXT("Selected %d/%d assets (Excluded Path:%d ParentClass:%d Tag:%d)"),
+		OutAssetData.Num(), FoundCount, PathExcludedCount, ParentClassExcludedCount, TagExcludedCount);
+	return true;
+}
+
+bool UBlueprintToDocUtil::GetBlueprintAssets(TArray<FAssetData>& OutAssetData)
+{
+	return GetProjectAssets(OutAssetData, { UBlueprint::StaticClass() }, true);
+}
+
+bool UBlueprintToDocUtil::GetTypeAssets(TArray<FAssetData>& OutAssetData)
+{
+	return GetProjectAssets(OutAssetData, { UUserDefinedStruct::StaticClass(), UUserDefinedEnum::StaticClass() }, false);
+}
+
+int32 UBlueprintToDocUtil::BlueprintToDocDryRun()
+{
+	TArray<FAssetData> BlueprintAssets;
+	TArray<FAssetData> TypeAssets;
+	if(!GetBlueprintAssets(BlueprintAssets) || !GetTypeAssets(TypeAssets))
+	{
+		return 0;
+	}
+
+	for(const TArray<FAssetData>* Assets : { &BlueprintAssets, &TypeAssets })
+	{
+		for(const FAssetData& AssetData : *Assets)
+		{
+			UE_LOG(LogBlueprintToDoc, Log, TEXT("DryRun: %s"), *AssetData.ObjectPath.ToString());
+		}
+	}
+	UE_LOG(LogBlueprintToDoc, Display, TEXT("DryRun: %d blueprints, %d types selected"), BlueprintAssets.Num(), TypeAssets.Num());
+	return BlueprintAssets.Num() + TypeAssets.Num();
+}
+
+void UBlueprintToDocUtil::MakeSymbolTable(FDocumentSymbolTable& OutSymbols, const TArray<FAssetData>& BlueprintAssets, const TArray<FAssetData>& TypeAssets)
+{
+	// 同じ名前のアセットの数(FNameの比較は大文字小文字を区別しないのでファイル名と同じ)
+	TMap<FName, int32> NameCounts;
+	for(const TArray<FAssetData>* Assets : { &BlueprintAssets, &TypeAssets })
+	{
+		for(const FAssetData& AssetData : *Assets)
+		{
+			NameCounts.FindOrAdd(AssetData.AssetName)++;
+		}
+	}
+
+	// 目次とレポートのページ名は使えない
+	TSet<FString> UsedPageNames;
+	UsedPageNames.Add(TEXT("toc"));
+	TArray<FString> ReportPageNames;
+	GetReportPageNames(ReportPageNames);
+	for(const FString& ReportPageName : ReportPageNames)
+	{
+		UsedPageNames.Add(FPaths::GetBaseFilename(ReportPageName));
+	}
+
+	auto AddPageName = [&OutSymbols, &NameCounts, &UsedPageNames](const FAssetData& AssetData)
+	{
+		FString PageName = AssetData.AssetName.ToString();
+		// 重複する場合はオブジェクトパスのハッシュを付ける(アセットの順に依らず同じ名前になる)
+		if(NameCounts.FindChecked(AssetData.AssetName) > 1 || UsedPageNames.Contains(PageName))
+		{
+			PageName += FString::Printf(TEXT("-%08x"), FCrc::StrCrc32(*AssetData.ObjectPath.ToString()));
+		}
+		// ハッシュも衝突した場合は番号を付ける
+		const FString HashedPageName = PageName;
+		for(int32 Suffix = 2; UsedPageNames.Contains(PageName); ++Suffix)
+		{
+			PageName = FString::Printf(TEXT("%s-%d"), *HashedPageName, Suffix);
+		}
+		UsedPageNames.Add(PageName);
+		return OutSymbols.PageNames.Add(AssetData.ObjectPath, PageName);
+	};
+
+	OutSymbols.PageNames.Reserve(BlueprintAssets.Num() * 2 + TypeAssets.Num());
+	for(const FAssetData& AssetData : BlueprintAssets)
+	{
+		// ピンやプロパティの型は生成クラスなので、生成クラスのパスでも引けるようにする
+		const FString PageName = AddPageName(AssetData);
+		OutSymbols.PageNames.Add(FName(*(AssetData.ObjectPath.ToString() + TEXT("_C"))), PageName);
+	}
+	for(const FAssetData& AssetData : TypeAssets)
+	{
+		AddPageName(AssetData);
+	}
+}
+
+bool UBlueprintToDocUtil::MakeBlueprintSnapshot(FBlueprintSnapshot& OutSnapshot, const FAssetData& AssetData, const FDocumentSymbolTable& Symbols, FBlueprintToDocLoadCost& LoadCost, FBlueprintToDocMacroCost& MacroCost)
+{
+	check(IsInGameThread());
+
+	// アセットをUBlueprintにキャスト
+	UBlueprint* BluprintClass = Cast<UBlueprint>(AssetData.GetAsset());
+	if(BluprintClass == nullptr)
+	{
+		return false;
+	}
+
+	FBlueprintDocument& OutBlueprintDocument = OutSnapshot.Document;
+
+	// TODOは整形時に探す
+	OutSnapshot.TodoMarkers = GetDefault<UBlueprintToDocUserSettings>()->TodoMarkers;
+
+	// BlueprintName
+	OutBlueprintDocument.Name = AssetData.AssetName.ToString();
+	// ページ名(シンボル表に無ければアセット名)
+	const FString* PageName = Symbols.FindPageName(AssetData.ObjectPath);
+	OutBlueprintDocument.PageName = (PageName != nullptr) ? *PageName : OutBlueprintDocument.Name;
+	// ToolTips
+	OutBlueprintDocument.ToolTips = BluprintClass->GeneratedClass->GetMetaData(TEXT("ToolTip"));
+	// Path
+	OutBlueprintDocument.ContentPath = AssetData.PackagePath.ToString();
+	// ハード参照
+	LoadCost.GetClosureSize(AssetData.PackageName, OutBlueprintDocument.HardReferenceCount, OutBlueprintDocument.HardReferenceDiskSize, OutBlueprintDocument.HardReferenceMemorySize);
+
+	UClass* const BPClass = BluprintClass->GeneratedClass;
+	if(BPClass)
+	{
+		// 親クラス名
+		OutBlueprintDocument.ParentName = BPClass->GetSuperStruct()->GetName();
+		OutBlueprintDocument.ParentPath = FName(*BPClass->GetSuperStruct()->GetPathName());
+
+		OutBlueprintDocument.bIsActor = BPClass->IsChildOf(AActor::StaticClass());
+
+		// 初期値(読まない設定ならCDOを作らない)
+		const UBlueprintToDocUserSettings* Settings = GetDefault<UBlueprintToDocUserSettings>();
+		const UObject* DefaultObject = BPClass->GetDefaultObject(Settings->bReadClassDefaults);
+
+		// Event
+		MakeEdGraphSnapshot(OutSnapshot.Events, BluprintClass, BluprintClass->EventGraphs);
+
+		// Macro
+		MakeEdGraphSnapshot(OutSnapshot.Macros, BluprintClass, BluprintClass->MacroGraphs);
+
+		// Function
+		MakeEdGraphSnapshot(OutSnapshot.Functions, BluprintClass, BluprintClass->FunctionGraphs);
+
+		// Component
+		MakeComponentDocuments(OutBlueprintDocument.Components, BluprintClass);
+
+		// AnimGraph
+		if(UAnimBlueprint* AnimBlueprint = Cast<UAnimBlueprint>(BluprintClass))
+		{
+			MakeAnimBlueprintDocument(OutBlueprintDocument, AnimBlueprint);
+		}
+
+		// Widget
+		if(UWidgetBlueprint* WidgetBlueprint = Cast<UWidgetBlueprint>(BluprintClass))
+		{
+			MakeWidgetBlueprintDocument(OutBlueprintDocument, WidgetBlueprint);
+		}
+
+		// マクロの展開
+		MakeMacroUsages(OutBlueprintDocument.MacroUsages, BluprintClass, MacroCost);
+
+		// Propery
+		for(TFieldIterator<UProperty> PropIt(BPClass); PropIt; ++PropIt)
+		{
+			UProperty* Property = *PropIt;
+
+			// エディタ上で作られたものだけリストに
+			if(Cast<UBlueprintGeneratedClass>(Property->GetOwnerClass()) != nullptr)
+			{
+				FPropertySnapshot PropertySnapshot;
+				FPropertyDocument& PropertyDocument = PropertySnapshot.Document;
+
+				PropertySnapshot.Name = Property->GetFName();
+
+				//プロパティの型をキャストして識別する
+				PropertySnapshot.bIsPropertyClassName = GetPropertyType(Property, PropertySnapshot.TypeName, PropertyDocument.TypePath);
+
+				PropertySnapshot.CategoryMetaData = Property->GetMetaData(TEXT("Category"));
+				PropertyDocument.ToolTips = Property->GetMetaData(TEXT("ToolTip"));
+
+				PropertyDocument.PropertyFlg = Property->GetPropertyFlags();
+				PropertyDocument.LifetimeCondition = Property->GetBlueprintReplicationCondition();
+
+				// 初期値(CDOが無ければ空)
+				const void* ValuePtr = DefaultObject ? Property->ContainerPtrToValuePtr<void>(DefaultObject) : nullptr;
+				if(ValuePtr)
+				{
+					Property->ExportTextItem(PropertyDocument.DefaultValue, ValuePtr, nullptr, nullptr, PPF_None);
+				}
+
+				// サイズ
+				PropertyDocument.Size = Property->ElementSize * Property->ArrayDim;
+				PropertyDocument.Offset = Property->GetOffset_ForInternal();
+				PropertyDocument.Alignment = Property->GetMinAlignment();
+				const UArrayProperty* ArrayProperty = Cast<UArrayProperty>(Property);
+				if(ArrayProperty && ValuePtr)
+				{
+					FScriptArrayHelper ArrayHelper(ArrayProperty, ValuePtr);
+					PropertyDocument.ElementCount = ArrayHelper.Num();
+				}
+
+				// レプリケーション
+				if(Property->HasAnyPropertyFlags(CPF_Net))
+				{
+					PropertyDocument.ReplicatedSize = EstimateReplicatedSize(Property, ValuePtr);
+					OutBlueprintDocument.ReplicatedSize += PropertyDocument.ReplicatedSize;
+					if(PropertyDocument.LifetimeCondition == COND_None)
+					{
+						OutBlueprintDocument.AlwaysReplicatedSize += PropertyDocument.ReplicatedSize;
+					}
+				}
+
+				OutSnapshot.Properties.Add(MoveTemp(PropertySnapshot));
+			}
+		}
+
+		// メモリレイアウト
+		MakeMemoryLayout(OutBlueprintDocument, BPClass);
+
+		// RPC
+		for(TFieldIterator<UFunction> FuncIt(BPClass, EFieldIteratorFlags::ExcludeSuper); FuncIt; ++FuncIt)
+		{
+			if(FuncIt->HasAnyFunctionFlags(FUNC_Net))
+			{
+				OutBlueprintDocument.RPCCount++;
+				if(FuncIt->HasAllFunctionFlags(FUNC_NetMulticast | FUNC_NetReliable))
+				{
+					OutBlueprintDocument.ReliableMulticastCount++;
+				}
+			}
+		}
+	}
+	return true;
+}
+
+void UBlueprintToDocUtil::MakeEdGraphSnapshot(TArray<FEdGraphSnapshot>& OutEdGraphSnapshot, class UBlueprint* Blueprint, const TArray<UEdGraph*>& EdGraphs)
+{
+	const UBlueprintToDocUserSettings* Settings = GetDefault<UBlueprintToDocUserSettings>();
+	UClass* const BPClass = Blueprint->GeneratedClass;
+	const FName BlueprintName = BPClass->GetFName();
+
+	for(UEdGraph* graph : EdGraphs)
+	{
+		FEdGraphSnapshot& AddEdGraphSnapshot = OutEdGraphSnapshot.AddDefaulted_GetRef();
+
+		AddEdGraphSnapshot.Document.Parent = BlueprintName;
+		AddEdGraphSnapshot.Document.GraphName = graph->GetFName();
+
+		// CDOを作らないようにクラスから探す
+		UFunction* CheckFunction = BPClass->FindFunctionByName(graph->GetFName());
+		if(CheckFunction != nullptr)
+		{
+			AddEdGraphSnapshot.bHasFunction = true;
+			AddEdGraphSnapshot.DisplayNameMetaData = CheckFunction->GetMetaData(FBlueprintMetadata::MD_DisplayName);
+			AddEdGraphSnapshot.CategoryMetaData = CheckFunction->GetMetaData(TEXT("Category"));
+			AddEdGraphSnapshot.ToolTipMetaData = CheckFunction->GetMetaData(TEXT("ToolTip"));
+			AddEdGraphSnapshot.Document.Flag = (uint64)CheckFunction->FunctionFlags;
+		}
+		else
+		{
+			FGraphDisplayInfo DisplayInfo;
+			graph->GetSchema()->GetGraphDisplayInformation(*graph, DisplayInfo);
+
+			AddEdGraphSnapshot.DisplayName = DisplayInfo.DisplayName;
+			AddEdGraphSnapshot.DisplayToolTip = DisplayInfo.Tooltip;
+		}
+
+		// 入出力ピン
+		for(UEdGraphNode* Node : graph->Nodes)
+		{
+			// コメントボックスもコメントはNodeCommentに入っている
+			if(!Node->NodeComment.IsEmpty())
+			{
+				AddEdGraphSnapshot.NodeComments.Add(Node->NodeComment);
+			}
+
+			const bool IsFunctionEntry = Node->IsA<UK2Node_FunctionEntry>();
+			const bool IsFunctionResult = Node->IsA<UK2Node_FunctionResult>();
+
+			if(IsFunctionEntry || IsFunctionResult)
+			{
+				// エントリーノードにコメントがついている場合はToolTipsに追加
+				if(IsFunctionEntry)
+				{
+					AddEdGraphSnapshot.EntryComment += Node->NodeComment;
+				}
+
+				TArray<FEdGraphPinSnapshot>& PinSnapshots = IsFunctionEntry ? AddEdGraphSnapshot.InputPins : AddEdGraphSnapshot.OutputPins;
+				for(const UEdGraphPin* Pin : Node->Pins)
+				{
+					FEdGraphPinSnapshot& PinSnapshot = PinSnapshots.AddDefaulted_GetRef();
+					PinSnapshot.Name = Pin->PinName;
+					PinSnapshot.PinCategory = Pin->PinType.PinCategory;
+					if(Pin->PinType.PinSubCategoryObject != nullptr)
+					{
+						PinSnapshot.SubCategoryObjectName = Pin->PinType.PinSubCategoryObject->GetFName();
+						PinSnapshot.SubCategoryObjectPath = FName(*Pin->PinType.PinSubCategoryObject->GetPathName());
+					}
+					if(Pin->DefaultObject != nullptr)
+					{
+						PinSnapshot.DefaultObjectPath = Pin->DefaultObject->GetPathName();
+					}
+					PinSnapshot.DefaultTextValue = Pin->DefaultTextValue;
+					PinSnapshot.DefaultValue = Pin->DefaultValue;
+					PinSnapshot.ToolTip = Pin->PinToolTip;
+				}
+			}
+		}
+
+		// 実行コスト
+		MakeEdGraphCost(AddEdGraphSnapshot.Document, graph);
+
+		// 描画用の配置
+		if(Settings->bEmbedGraphSVG)
+		{
+			MakeEdGraphLayout(AddEdGraphSnapshot.Document, graph);
+		}
+	}
+}
+
+void UBlueprintToDocUtil::FormatBlueprintSnapshot(FBlueprintDocument& OutBlueprintDocument, const FBlueprintSnapshot& Snapshot)
+{
+	OutBlueprintDocument = Snapshot.Document;
+
+	// Event
+	FormatEdGraphSnapshot(OutBlueprintDocument.Events, Snapshot.Events, Snapshot.TodoMarkers);
+	// Macro
+	FormatEdGraphSnapshot(OutBlueprintDocument.Macros, Snapshot.Macros, Snapshot.TodoMarkers);
+	// Function
+	FormatEdGraphSnapshot(OutBlueprintDocument.Functions, Snapshot.Functions, Snapshot.TodoMarkers);
+
+	// Propery
+	OutBlueprintDocument.Properties.Reserve(Snapshot.Properties.Num());
+	for(const FPropertySnapshot& PropertySnapshot : Snapshot.Properties)
+	{
+		FPropertyDocument& PropertyDocument = OutBlueprintDocument.Properties.Add_GetRef(PropertySnapshot.Document);
+		PropertyDocument.Name = PropertySnapshot.Name.ToString();
+		PropertyDocument.Type = PropertySnapshot.bIsPropertyClassName ? TrimPropertyClassName(PropertySnapshot.TypeName) : PropertySnapshot.TypeName;
+		PropertyDocument.Category = MakeCategoryName(PropertySnapshot.CategoryMetaData);
+	}
+
+	//ソート
+	OutBlueprintDocument.Events.Sort(FGraphSorter());
+	OutBlueprintDocument.Macros.Sort(FGraphSorter());
+	OutBlueprintDocument.Functions.Sort(FGraphSorter());
+	OutBlueprintDocument.Properties.Sort(FPropertySorter());
+}
+
+void UBlueprintToDocUtil::FormatEdGraphSnapshot(TArray<FEdGraphDocument>& OutEdGraphDocument, const TArray<FEdGraphSnapshot>& EdGraphSnapshots, const TArray<FString>& TodoMarkers)
+{
+	// ピンの型と初期値
+	auto MakePinDocument = [](const FEdGraphPinSnapshot& PinSnapshot)
+	{
+		FEdGraphPinDocument PinDocument;
+		PinDocument.Name = PinSnapshot.Name.ToString();
+		PinDocument.Type = (PinSnapshot.SubCategoryObjectName != NAME_None) ? PinSnapshot.SubCategoryObjectName : PinSnapshot.PinCategory;
+		PinDocument.TypePath = PinSnapshot.SubCategoryObjectPath;
+
+		// UEdGraphPin::GetDefaultAsString と同じ優先順
+		if(!PinSnapshot.DefaultObjectPath.IsEmpty())
+		{
+			PinDocument.DefaultValue = PinSnapshot.DefaultObjectPath;
+		}
+		else if(!PinSnapshot.DefaultTextValue.IsEmpty())
+		{
+			FTextStringHelper::WriteToString(PinDocument.DefaultValue, PinSnapshot.DefaultTextValue);
+		}
+		else
+		{
+			PinDocument.DefaultValue = PinSnapshot.DefaultValue;
+		}
+		PinDocument.ToolTips = PinSnapshot.ToolTip;
+		return PinDocument;
+	};
+
+	OutEdGraphDocument.Reserve(OutEdGraphDocument.Num() + EdGraphSnapshots.Num());
+	for(const FEdGraphSnapshot& EdGraphSnapshot : EdGraphSnapshots)
+	{
+		FEdGraphDocument& AddEdGraphDocument = OutEdGraphDocument.Add_GetRef(EdGraphSnapshot.Document);
+
+		if(EdGraphSnapshot.bHasFunction)
+		{
+			AddEdGraphDocument.Name = EdGraphSnapshot.DisplayNameMetaData;
+			AddEdGraphDocument.Category = MakeCategoryName(EdGraphSnapshot.CategoryMetaData);
+			AddEdGraphDocument.ToolTips = EdGraphSnapshot.ToolTipMetaData;
+		}
+		else
+		{
+			AddEdGraphDocument.Name = EdGraphSnapshot.DisplayName.ToString();
+			AddEdGraphDocument.ToolTips = EdGraphSnapshot.DisplayToolTip.ToString();
+		}
+		if(AddEdGraphDocument.Name.IsEmpty())
+		{
+			AddEdGraphDocument.Name = AddEdGraphDocument.GraphName.ToString();
+		}
+		AddEdGraphDocument.ToolTips += EdGraphSnapshot.EntryComment;
+
+		// TODO
+		for(const FString& NodeComment : EdGraphSnapshot.NodeComments)
+		{
+			FindTodoLines(AddEdGraphDocument.TodoList, NodeComment, TodoMarkers);
+		}
+
+		// 入出力ピン
+		AddEdGraphDocument.Input.Reserve(EdGraphSnapshot.InputPins.Num());
+		for(const FEdGraphPinSnapshot& PinSnapshot : EdGraphSnapshot.InputPins)
+		{
+			AddEdGraphDocument.Input.Add(MakePinDocument(PinSnapshot));
+		}
+		AddEdGraphDocument.Output.Reserve(EdGraphSnapshot.OutputPins.Num());
+		for(const FEdGraphPinSnapshot& PinSnapshot : EdGraphSnapshot.OutputPins)
+		{
+			AddEdGraphDocument.Output.Add(MakePinDocument(PinSnapshot));
+		}
+	}
+}
+
+void UBlueprintToDocUtil::MakeComponentDocuments(TArray<FComponentDocument>& OutComponentDocuments, UBlueprint* Blueprint)
+{
+	// 親のブループリントのコンポーネントを上書きしたテンプレート
+	TMap<const USCS_Node*, const UActorComponent*> OverriddenTemplates;
+	if(UInheritableComponentHandler* InheritableComponentHandler = Blueprint->GetInheritableComponentHandler(false))
+	{
+		TArray<UActorComponent*> Templates;
+		InheritableComponentHandler->GetAllTemplates(Templates);
+		for(UActorComponent* Template : Templates)
+		{
+			if(const USCS_Node* Node = InheritableComponentHandler->FindKey(Template).FindSCSNode())
+			{
+				OverriddenTemplates.Add(Node, Template);
+			}
+		}
+	}
+
+	// 親のブループリントから順に並べる
+	TArray<const UBlueprintGeneratedClass*, TInlineAllocator<8>> GeneratedClasses;
+	for(const UClass* Class = Blueprint->GeneratedClass; Class != nullptr; Class = Class->GetSuperClass())
+	{
+		if(const UBlueprintGeneratedClass* GeneratedClass = Cast<const UBlueprintGeneratedClass>(Class))
+		{
+			GeneratedClasses.Insert(GeneratedClass, 0);
+		}
+	}
+
+	for(const UBlueprintGeneratedClass* GeneratedClass : GeneratedClasses)
+	{
+		const USimpleConstructionScript* SimpleConstructionScript = GeneratedClass->SimpleConstructionScript;
+		if(SimpleConstructionScript == nullptr)
+		{
+			continue;
+		}
+		const bool bInherited = (GeneratedClass != Blueprint->GeneratedClass);
+		for(const USCS_Node* RootNode : SimpleConstructionScript->GetRootNodes())
+		{
+			AddComponentDocuments(OutComponentDocuments, RootNode, NAME_None, 0, bInherited, OverriddenTemplates);
+		}
+	}
+}
+
+void UBlueprintToDocUtil::MakeAnimBlueprintDocument(FBlueprintDocument& OutBlueprintDocument, UAnimBlueprint* AnimBlueprint)
+{
+	OutBlueprintDocument.bIsAnimBlueprint = true;
+	// 無効な場合は入力の評価も含めてゲームスレッドで更新される
+	OutBlueprintDocument.bUseMultiThreadedAnimationUpdate = AnimBlueprint->bUseMultiThreadedAnimationUpdate;
+
+	// AnimGraphは関数のグラフに入っている
+	for(const UEdGraph* EdGraph : AnimBlueprint->FunctionGraphs)
+	{
+		if(EdGraph != nullptr && EdGraph->IsA<UAnimationGraph>())
+		{
+			AddAnimNodeDocuments(OutBlueprintDocument, EdGraph, EdGraph->GetName());
+		}
+	}
+}
+
+void UBlueprintToDocUtil::MakeWidgetBlueprintDocument(FBlueprintDocument& OutBlueprintDocument, UWidgetBlueprint* WidgetBlueprint)
+{
+	OutBlueprintDocument.bIsWidgetBlueprint = true;
+
+	// バインド
+	for(const FDelegateEditorBinding& Binding : WidgetBlueprint->Bindings)
+	{
+		FWidgetBindingDocument& BindingDocument = OutBlueprintDocument.WidgetBindings.AddDefaulted_GetRef();
+		BindingDocument.Widget = Binding.ObjectName;
+		BindingDocument.Property = Binding.PropertyName;
+		if(Binding.Kind == EBindingKind::Function)
+		{
+			BindingDocument.FunctionName = Binding.FunctionName;
+		}
+		else
+		{
+			BindingDocument.SourcePath = Binding.SourcePath.IsEmpty() ? Binding.SourceProperty.ToString() : Binding.SourcePath.GetDisplayText().ToString();
+		}
+	}
+
+	// 自身のTick
+	if(WidgetBlueprint->GeneratedClass != nullptr && HasBlueprintTick(WidgetBlueprint->GeneratedClass))
+	{
+		OutBlueprintDocument.WidgetTickOverrides.Add(OutBlueprintDocument.Name);
+	}
+
+	if(WidgetBlueprint->WidgetTree == nullptr)
+	{
+		return;
+	}
+
+	// bIsVolatileはprotectedなのでリフレクションで読む
+	const UBoolProperty* VolatileProperty = FindField<UBoolProperty>(UWidget::StaticClass(), TEXT("bIsVolatile"));
+
+	TArray<UWidget*> Widgets;
+	WidgetBlueprint->WidgetTree->GetAllWidgets(Widgets);
+	OutBlueprintDocument.WidgetCount = Widgets.Num();
+	for(const UWidget* Widget : Widgets)
+	{
+		int32 Depth = 1;
+		for(const UPanelWidget* Parent = Widget->GetParent(); Parent != nullptr; Parent = Parent->GetParent())
+		{
+			++Depth;
+		}
+		OutBlueprintDocument.WidgetTreeDepth = FMath::Max(OutBlueprintDocument.WidgetTreeDepth, Depth);
+
+		if(VolatileProperty != nullptr && VolatileProperty->GetPropertyValue_InContainer(Widget))
+		{
+			OutBlueprintDocument.VolatileWidgetCount++;
+		}
+		if(Widget->IsA<UInvalidationBox>())
+		{
+			OutBlueprintDocument.InvalidationBoxCount++;
+		}
+		if(Widget->IsA<URetainerBox>())
+		{
+			OutBlueprintDocument.RetainerBoxCount++;
+		}
+
+		// 子のユーザーウィジェットのTickも毎フレーム呼ばれる
+		if(Widget->IsA<UUserWidget>() && HasBlueprintTick(Widget->GetClass()))
+		{
+			OutBlueprintDocument.WidgetTickOverrides.Add(FString::Printf(TEXT("%s (%s)"), *Widget->GetName(), *Widget->GetClass()->GetName()));
+		}
+	}
+}
+
+void UBlueprintToDocUtil::MakeMacroUsages(TArray<FMacroUsageDocument>& OutMacroUsages, UBlueprint* Blueprint, FBlueprintToDocMacroCost& MacroCost)
+{
+	// マクロのグラフは使われた所で展開されるので、コンパイルされるグラフだけ数える
+	TMap<const UEdGraph*, int32> UsageIndices;
+	for(const TArray<UEdGraph*>* EdGraphs : { &Blueprint->UbergraphPages, &Blueprint->FunctionGraphs })
+	{
+		for(const UEdGraph* EdGraph : *EdGraphs)
+		{
+			if(EdGraph != nullptr)
+			{
+				AddMacroUsages(OutMacroUsages, UsageIndices, EdGraph, MacroCost);
+			}
+		}
+	}
+
+	OutMacroUsages.Sort([](const FMacroUsageDocument& A, const FMacroUsageDocument& B)
+	{
+		return A.InstanceCount * A.ExpandedNodeCount > B.InstanceCount * B.ExpandedNodeCount;
+	});
+}
+
+bool UBlueprintToDocUtil::MakeTypeDocument(FTypeDocument& OutTypeDocument, const FAssetData& AssetData, const FDocumentSymbolTable& Symbols)
+{
+	check(IsInGameThread());
+
+	UObject* Asset = AssetData.GetAsset();
+
+	OutTypeDocument.Name = AssetData.AssetName.ToString();
+	const FString* PageName = Symbols.FindPageName(AssetData.ObjectPath);
+	OutTypeDocument.PageName = (PageName != nullptr) ? *PageName : OutTypeDocument.Name;
+	OutTypeDocument.ContentPath = AssetData.PackagePath.ToString();
+
+	if(UUserDefinedStruct* Struct = Cast<UUserDefinedStruct>(Asset))
+	{
+		OutTypeDocument.ToolTips = Struct->GetMetaData(TEXT("ToolTip"));
+
+		// 初期値
+		const uint8* DefaultInstance = Struct->GetDefaultInstance();
+		for(TFieldIterator<UProperty> PropIt(Struct); PropIt; ++PropIt)
+		{
+			UProperty* Property = *PropIt;
+			FPropertyDocument& MemberDocument = OutTypeDocument.Members.AddDefaulted_GetRef();
+
+			// 変数名にはGUIDが付いているのでエディタで付けた名前にする
+			MemberDocument.Name = Struct->GetAuthoredNameForField(Property);
+			FName TypeName;
+			MemberDocument.Type = GetPropertyType(Property, TypeName, MemberDocument.TypePath) ? TrimPropertyClassName(TypeName) : TypeName;
+			MemberDocument.ToolTips = Property->GetMetaData(TEXT("ToolTip"));
+			MemberDocument.PropertyFlg = Property->GetPropertyFlags();
+			if(DefaultInstance != nullptr)
+			{
+				Property->ExportTextItem(MemberDocument.DefaultValue, Property->ContainerPtrToValuePtr<void>(DefaultInstance), nullptr, nullptr, PPF_None);
+			}
+		}
+		return true;
+	}
+
+	if(UUserDefinedEnum* Enum = Cast<UUserDefinedEnum>(Asset))
+	{
+		OutTypeDocument.bIsEnum = true;
+#if WITH_EDITORONLY_DATA
+		OutTypeDocument.ToolTips = Enum->EnumDescription.ToString();
+#endif
+
+		// 最後の要素は自動で追加される _MAX
+		for(int32 Index = 0; Index < Enum->NumEnums() - 1; ++Index)
+		{
+			FPropertyDocument& MemberDocument = OutTypeDocument.Members.AddDefaulted_GetRef();
+			MemberDocument.Name = Enum->GetDisplayNameTextByIndex(Index).ToString();
+			MemberDocument.DefaultValue = LexToString(Enum->GetValueByIndex(Index));
+			MemberDocument.ToolTips = Enum->GetMetaData(TEXT("ToolTip"), Index);
+			MemberDocument.PropertyFlg = 0;
+		}
+		return true;
+	}
+	return false;
+}
+
+void UBlueprintToDocUtil::MakeMemoryLayout(FBlueprintDocument& OutBlueprintDocument, const UClass* Class)
+{
+	struct FLayoutProperty
+	{
+		FString Name;
+		int32 Offset;
+		int32 Size;
+		int32 Alignment;
+	};
+
+	// このクラスで追加したプロパティ
+	TArray<FLayoutProperty> LayoutProperties;
+	for(TFieldIterator<UProperty> PropIt(Class, EFieldIteratorFlags::ExcludeSuper); PropIt; ++PropIt)
+	{
+		LayoutProperties.Add({ PropIt->GetName(), PropIt->GetOffset_ForInternal(), PropIt->ElementSize * PropIt->ArrayDim, PropIt->GetMinAlignment() });
+	}
+
+	const UStruct* SuperStruct = Class->GetSuperStruct();
+	const int32 SuperSize = (SuperStruct != nullptr) ? SuperStruct->GetPropertiesSize() : 0;
+	OutBlueprintDocument.InstanceSize = Class->GetPropertiesSize();
+
+	// 現在の並びでのパディング
+	LayoutProperties.Sort([](const FLayoutProperty& A, const FLayoutProperty& B) { return A.Offset < B.Offset; });
+	int32 Cursor = SuperSize;
+	for(const FLayoutProperty& LayoutProperty : LayoutProperties)
+	{
+		OutBlueprintDocument.PaddingSize += FMath::Max(LayoutProperty.Offset - Cursor, 0);
+		Cursor = FMath::Max(Cursor, LayoutProperty.Offset + LayoutProperty.Size);
+	}
+	OutBlueprintDocument.PaddingSize += FMath::Max(OutBlueprintDocument.InstanceSize - Cursor, 0);
+
+	// アラインメントの大きい順に並べるとパディングが最小になる
+	LayoutProperties.StableSort([](const FLayoutProperty& A, const FLayoutProperty& B)
+	{
+		if(A.Alignment != B.Alignment)
+		{
+			return A.Alignment > B.Alignment;
+		}
+		return A.Size > B.Size;
+	});
+	Cursor = SuperSize;
+	for(const FLayoutProperty& LayoutProperty : LayoutProperties)
+	{
+		Cursor = Align(Cursor, FMath::Max(LayoutProperty.Alignment, 1)) + LayoutProperty.Size;
+		OutBlueprintDocument.SuggestedPropertyOrder.Add(LayoutProperty.Name);
+	}
+	OutBlueprintDocument.OptimizedInstanceSize = FMath::Min(Align(Cursor, FMath::Max(Class->GetMinAlignment(), 1)), OutBlueprintDocument.InstanceSize);
+}
+
+int32 UBlueprintToDocUtil::EstimateReplicatedSize(const UProperty* Property, const void* ValuePtr)
+{
+	// ValuePtr が無い場合は可変長の部分を0として見積もる
+	int32 Size = 0;
+
+	if(Property->IsA<UBoolProperty>())
+	{
+		// 1ビットだが最低1バイトとして扱う
+		Size = 1;
+	}
+	else if(Property->IsA<UObjectPropertyBase>() || Property->IsA<UInterfaceProperty>())
+	{
+		// NetGUID
+		Size = 4;
+	}
+	else if(const UStrProperty* StrProperty = Cast<UStrProperty>(Property))
+	{
+		// 長さ + 文字列
+		Size = 4 + (ValuePtr ? StrProperty->GetPropertyValue(ValuePtr).Len() : 0);
+	}
+	else if(const UNameProperty* NameProperty = Cast<UNameProperty>(Property))
+	{
+		Size = 4 + (ValuePtr ? NameProperty->GetPropertyValue(ValuePtr).GetStringLength() : 0);
+	}
+	else if(const UTextProperty* TextProperty = Cast<UTextProperty>(Property))
+	{
+		Size = 4 + (ValuePtr ? TextProperty->GetPropertyValue(ValuePtr).ToString().Len() : 0);
+	}
+	else if(const UStructProperty* StructProperty = Cast<UStructProperty>(Property))
+	{
+		for(TFieldIterator<UProperty> PropIt(StructProperty->Struct); PropIt; ++PropIt)
+		{
+			Size += EstimateReplicatedSize(*PropIt, ValuePtr ? PropIt->ContainerPtrToValuePtr<void>(ValuePtr) : nullptr);
+		}
+	}
+	else if(const UArrayProperty* ArrayProperty = Cast<UArrayProperty>(Property))
+	{
+		// 要素数 + 要素
+		Size = 4;
+		if(ValuePtr)
+		{
+			FScriptArrayHelper ArrayHelper(ArrayProperty, ValuePtr);
+			for(int32 Index = 0; Index < ArrayHelper.Num(); ++Index)
+			{
+				Size += EstimateReplicatedSize(ArrayProperty->Inner, ArrayHelper.GetRawPtr(Index));
+			}
+		}
+	}
+	else if(Property->IsA<USetProperty>() || Property->IsA<UMapProperty>())
+	{
+		// SetとMapはレプリケーションされない
+		Size = 0;
+	}
+	else
+	{
+		// 数値、列挙型
+		Size = Property->ElementSize;
+	}
+
+	return Size * Property->ArrayDim;
+}
+
+void UBlueprintToDocUtil::MakeEdGraphCost(FEdGraphDocument& OutEdGraphDocument, UEdGraph* EdGraph)
+{
+	const UBlueprintToDocUserSettings* Settings = GetDefault<UBlueprintToDocUserSettings>();
+
+	OutEdGraphDocument.NodeCount = EdGraph->Nodes.Num();
+
+	// ホットイベントから実行されるノードを辿る
+	TSet<UEdGraphNode*> HotNodes;
+	TArray<UEdGraphNode*> OpenNodes;
+	for(UEdGraphNode* Node : EdGraph->Nodes)
+	{
+		UK2Node_Event* EventNode = Cast<UK2Node_Event>(Node);
+		if(EventNode != nullptr && Settings->HotEventNames.Contains(EventNode->EventReference.GetMemberName()))
+		{
+			OpenNodes.Add(EventNode);
+		}
+	}
+	while(OpenNodes.Num() > 0)
+	{
+		UEdGraphNode* Node = OpenNodes.Pop(false);
+		bool bAlreadyInSet = false;
+		HotNodes.Add(Node, &bAlreadyInSet);
+		if(bAlreadyInSet)
+		{
+			continue;
+		}
+
+		// 折りたたんだグラフと、同じブループリントの関数の中も辿る
+		if(UK2Node_Composite* Composite = Cast<UK2Node_Composite>(Node))
+		{
+			if(Composite->BoundGraph != nullptr && Composite->GetEntryNode() != nullptr)
+			{
+				OpenNodes.Add(Composite->GetEntryNode());
+			}
+		}
+		else if(UK2Node_CallFunction* CallFunction = Cast<UK2Node_CallFunction>(Node))
+		{
+			const UEdGraphNode* FunctionGraphNode = nullptr;
+			if(UEdGraph* FunctionGraph = CallFunction->GetFunctionGraph(FunctionGraphNode))
+			{
+				for(UEdGraphNode* FunctionNode : FunctionGraph->Nodes)
+				{
+					if(FunctionNode->IsA<UK2Node_FunctionEntry>())
+					{
+						OpenNodes.Add(FunctionNode);
+					}
+				}
+			}
+		}
+
+		for(UEdGraphPin* Pin : Node->Pins)
+		{
+			// 実行ピンの接続先と、入力ピンで評価されるピュアノード
+			const bool bExecOutput = (Pin->Direction == EGPD_Output) && (Pin->PinType.PinCategory == UEdGraphSchema_K2::PC_Exec);
+			const bool bDataInput = (Pin->Direction == EGPD_Input) && (Pin->PinType.PinCategory != UEdGraphSchema_K2::PC_Exec);
+			if(!bExecOutput && !bDataInput)
+			{
+				continue;
+			}
+			for(UEdGraphPin* LinkedPin : Pin->LinkedTo)
+			{
+				UEdGraphNode* LinkedNode = LinkedPin->GetOwningNode();
+				if(bDataInput && !IsPureNode(LinkedNode))
+				{
+					continue;
+				}
+				OpenNodes.Add(LinkedNode);
+			}
+		}
+	}
+
+	OutEdGraphDocument.HotNodeCount = HotNodes.Num();
+	for(UEdGraphNode* Node : HotNodes)
+	{
+		if(UK2Node_MacroInstance* MacroInstance = Cast<UK2Node_MacroInstance>(Node))
+		{
+			TSet<const UEdGraph*> VisitedGraphs;
+			if(IsLoopMacro(MacroInstance->GetMacroGraph(), VisitedGraphs))
+			{
+				OutEdGraphDocument.HotLoopCount++;
+			}
+		}
+		else if(Node->IsA<UK2Node_DynamicCast>())
+		{
+			OutEdGraphDocument.HotCastCount++;
+		}
+		else if(UK2Node_CallFunction* CallFunction = Cast<UK2Node_CallFunction>(Node))
+		{
+			if(Settings->ActorSearchFunctionNames.Contains(CallFunction->FunctionReference.GetMemberName()))
+			{
+				OutEdGraphDocument.HotActorSearchCount++;
+			}
+		}
+	}
+
+	// ピュアノードは接続先の実行ノードごとに再評価される
+	TMap<UEdGraphNode*, int32> ConsumerMemo;
+	for(UEdGraphNode* Node : EdGraph->Nodes)
+	{
+		if(IsPureNode(Node))
+		{
+			OutEdGraphDocument.PureReevaluationCount += FMath::Max(CountPureConsumers(Node, ConsumerMemo) - 1, 0);
+		}
+	}
+}
+
+void UBlueprintToDocUtil::MakeEdGraphLayout(FEdGraphDocument& OutEdGraphDocument, UEdGraph* EdGraph)
+{
+	// ピン → ノードとピンのインデックス
+	TMap<const UEdGraphPin*, TPair<int32, int32>> PinIndices;
+
+	OutEdGraphDocument.NodeLayouts.Reserve(EdGraph->Nodes.Num());
+	for(UEdGraphNode* Node : EdGraph->Nodes)
+	{
+		const int32 NodeIndex = OutEdGraphDocument.NodeLayouts.Num();
+		FEdGraphNodeLayout& NodeLayout = OutEdGraphDocument.NodeLayouts.AddDefaulted_GetRef();
+
+		// 2行目以降はターゲット等の補足なので省く
+		NodeLayout.Title = Node->GetNodeTitle(ENodeTitleType::FullTitle).ToString();
+		int32 NewLinePosition;
+		if(NodeLayout.Title.FindChar(TEXT('\n'), NewLinePosition))
+		{
+			NodeLayout.Title = NodeLayout.Title.Left(NewLinePosition);
+		}
+		NodeLayout.X = Node->NodePosX;
+		NodeLayout.Y = Node->NodePosY;
+		NodeLayout.Width = Node->NodeWidth;
+		NodeLayout.Height = Node->NodeHeight;
+		NodeLayout.bIsComment = Node->IsA<UEdGraphNode_Comment>();
+
+		for(const UEdGraphPin* Pin : Node->Pins)
+		{
+			if(Pin->bHidden)
+			{
+				continue;
+			}
+			TArray<FEdGraphPinLayout>& PinLayouts = (Pin->Direction == EGPD_Input) ? NodeLayout.Inputs : NodeLayout.Outputs;
+			PinIndices.Add(Pin, TPair<int32, int32>(NodeIndex, PinLayouts.Num()));
+
+			FEdGraphPinLayout& PinLayout = PinLayouts.AddDefaulted_GetRef();
+			PinLayout.Name = Pin->GetDisplayName().ToString().Replace(TEXT("\n"), TEXT(" "));
+			PinLayout.Category = Pin->PinType.PinCategory;
+		}
+	}
+
+	// 接続は出力ピンの側から数える
+	for(UEdGraphNode* Node : EdGraph->Nodes)
+	{
+		for(const UEdGraphPin* Pin : Node->Pins)
+		{
+			const TPair<int32, int32>* FromPin = (Pin->Direction == EGPD_Output) ? PinIndices.Find(Pin) : nullptr;
+			if(FromPin == nullptr)
+			{
+				continue;
+			}
+			for(const UEdGraphPin* LinkedPin : Pin->LinkedTo)
+			{
+				if(const TPair<int32, int32>* ToPin = PinIndices.Find(LinkedPin))
+				{
+					FEdGraphWireLayout& WireLayout = OutEdGraphDocument.WireLayouts.AddDefaulted_GetRef();
+					WireLayout.FromNode = FromPin->Key;
+					WireLayout.FromPin = FromPin->Value;
+					WireLayout.ToNode = ToPin->Key;
+					WireLayout.ToPin = ToPin->Value;
+				}
+			}
+		}
+	}
+}
+
+void UBlueprintToDocUtil::IndexToHTML(FDocument& Document)
+{
+	Document.Blueprints.Sort(FBlueprintSorter());
+	Document.Types.Sort([](const FTypeDocument& A, const FTypeDocument& B)
+	{
+		return A.ContentPath < B.ContentPath;
+	});
+
+	FHTMLPages Pages;
+
+	// 目次ページ
+	TOCPageHTML(Pages.Add(TEXT("toc.html")), Document);
+
+	// 構造体、enumのページ
+	for(const FTypeDocument& TypeDocument : Document.Types)
+	{
+		TypePageHTML(Pages.Add(TypeDocument.PageName + TEXT(".html")), TypeDocument, Document.GetSymbols());
+	}
+
+	// レポートページ
+	ReportPagesHTML(Pages, Document);
+	SaveHTMLPages(Document.RootPath, Pages);
+
+	// 必要なファイルをコピー
+	IPlatformFile &PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	const FString LaytoutTemplateDirectory = GetHTMLTemplateDirectory();
+	FString Path;
+
+	// index ページのコピー
+	{
+		Path = Document.RootPath / "index.html";
+		FString LaytoutTemplatePath = LaytoutTemplateDirectory / "index.html";
+		if (!PlatformFile.CopyFile(*Path, *LaytoutTemplatePath))
+		{
+			UE_LOG(LogBlueprintToDoc, Error, TEXT("Failed Copy File:%s"), *LaytoutTemplatePath);
+		}
+	}
+	// CSSファイルのコピー
+	{
+		Path = Document.RootPath / "Layout.css";
+		FString LaytoutTemplatePath = LaytoutTemplateDirectory / "Layout.css";
+		if (!PlatformFile.CopyFile(*Path, *LaytoutTemplatePath))
+		{
+			UE_LOG(LogBlueprintToDoc, Error, TEXT("Failed Copy File:%s"), *LaytoutTemplatePath);
+		}
+	}
+}
+
+FString UBlueprintToDocUtil::GetHTMLTemplateDirectory()
+{
+	IPlatformFile &PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+
+	// プロジェクトプラグインにプラグインが入っているか確認する
+	FString LaytoutTemplateDirectory = FPaths::ProjectPluginsDir() / "BlueprintToDoc";
+	if (!PlatformFile.DirectoryExists(*LaytoutTemplateDirectory))
+	{
+		// プロジェクト側になければエンジンプラグインとする
+		LaytoutTemplateDirectory = FPaths::EnginePluginsDir() / "BlueprintToDoc";
+	}
+	return LaytoutTemplateDirectory / "HTMLTemplate";
+}
+
+void UBlueprintToDocUtil::TOCPageHTML(FBlueprintToDocHTMLWriter& OutHTML, const FDocument& Document)
+{
+	const UBlueprintToDocUserSettings* Settings = GetDefault<UBlueprintToDocUserSettings>();
+
+	FString LastTOCPath;
+
+	// カテゴリ プロパティのページのリンクは先頭に
+	for (FName CatagoryName : Settings->ListupCategories)
+	{
+		AddLink(OutHTML, CatagoryName.ToString() + TEXT(".html"), CatagoryName.ToString());
+		OutHTML.Append("</br>\n");
+	}
+	// レポートページ
+	OutHTML.Append("<a href=\"heavy_blueprints.html\" target=\"document\">HeavyBlueprints</a></br>\n");
+	OutHTML.Append("<a href=\"hotspots.html\" target=\"document\">Hotspots</a></br>\n");
+	OutHTML.Append("<a href=\"replication.html\" target=\"document\">Replication</a></br>\n");
+	OutHTML.Append("<a href=\"memory_layout.html\" target=\"document\">MemoryLayout</a></br>\n");
+	OutHTML.Append("<a href=\"todo.html\" target=\"document\">Todo</a></br>\n");
+	OutHTML.Append("<a href=\"anim_blueprints.html\" target=\"document\">AnimBlueprints</a></br>\n");
+	OutHTML.Append("<a href=\"widget_blueprints.html\" target=\"document\">WidgetBlueprints</a></br>\n");
+	OutHTML.Append("<a href=\"macros.html\" target=\"document\">Macros</a></br>\n");
+
+	// ブループリント
+	for(const FBlueprintDocument& BlueprintDocument : Document.Blueprints)
+	{
+		if(LastTOCPath != BlueprintDocument.ContentPath)
+		{
+			LastTOCPath = BlueprintDocument.ContentPath;
+			TopicHTML(OutHTML, 3, BlueprintDocument.ContentPath);
+		}
+		AddLink(OutHTML, BlueprintDocument.PageName + TEXT(".html"), BlueprintDocument.Name);
+		OutHTML.Append("</br>\n");
+	}
+
+	// 構造体、enum
+	if(Document.Types.Num() > 0)
+	{
+		TopicHTML(OutHTML, 2, "Types");
+		LastTOCPath.Reset();
+		for(const FTypeDocument& TypeDocument : Document.Types)
+		{
+			if(LastTOCPath != TypeDocument.ContentPath)
+			{
+				LastTOCPath = TypeDocument.ContentPath;
+				TopicHTML(OutHTML, 3, TypeDocument.ContentPath);
+			}
+			AddLink(OutHTML, TypeDocument.PageName + TEXT(".html"), TypeDocument.Name);
+			OutHTML.Append("</br>\n");
+		}
+	}
+}
+
+void UBlueprintToDocUtil::BlueprintPageHTML(FHTMLPages& OutPages, const FBlueprintDocument& BlueprintDocument, const FDocumentSymbolTable& Symbols)
+{
+	FBlueprintToDocHTMLWriter PageHTML;
+
+	// タイトル
+	TopicHTML(PageHTML,1,BlueprintDocument.Name);
+	// 説明
+	PageHTML.AppendEscaped(BlueprintDocument.ToolTips);
+	PageHTML.Append("</br>");
+	// Path
+	TopicHTML(PageHTML, 2, "ContentPath");
+	PageHTML.AppendEscaped(BlueprintDocument.ContentPath);
+	PageHTML.Append("</br>");
+	// Parent
+	TopicHTML(PageHTML, 2, "Parent");
+	AddType(PageHTML, FName(*BlueprintDocument.ParentName), BlueprintDocument.ParentPath, Symbols);
+	PageHTML.Append("</br>");
+	// ハード参照
+	TopicHTML(PageHTML, 2, "HardReference");
+	PageHTML.AppendInt(BlueprintDocument.HardReferenceCount);
+	PageHTML.Append(" Packages / Disk ");
+	PageHTML.Append(SizeToString(BlueprintDocument.HardReferenceDiskSize));
+	PageHTML.Append(" / Memory ");
+	PageHTML.Append(SizeToString(BlueprintDocument.HardReferenceMemorySize));
+	PageHTML.Append("</br>");
+	// メモリレイアウト
+	TopicHTML(PageHTML, 2, "MemoryLayout");
+	PageHTML.Append("Instance ");
+	PageHTML.Append(SizeToString(BlueprintDocument.InstanceSize));
+	PageHTML.Append(" / Padding ");
+	PageHTML.Append(SizeToString(BlueprintDocument.PaddingSize));
+	PageHTML.Append(" / Optimized ");
+	PageHTML.Append(SizeToString(BlueprintDocument.OptimizedInstanceSize));
+	PageHTML.Append("</br>");
+
+	// Component
+	if(BlueprintDocument.Components.Num() > 0)
+	{
+		TopicHTML(PageHTML, 2, "Components");
+		ComponentsTableHTML(PageHTML, BlueprintDocument.Components, Symbols);
+	}
+
+	// AnimGraph
+	if(BlueprintDocument.bIsAnimBlueprint)
+	{
+		TopicHTML(PageHTML, 2, "AnimGraph");
+		AnimGraphTableHTML(PageHTML, BlueprintDocument);
+	}
+
+	// Widget
+	if(BlueprintDocument.bIsWidgetBlueprint)
+	{
+		TopicHTML(PageHTML, 2, "Widget");
+		WidgetTableHTML(PageHTML, BlueprintDocument);
+	}
+
+	// マクロの展開
+	if(BlueprintDocument.MacroUsages.Num() > 0)
+	{
+		TopicHTML(PageHTML, 2, "MacroExpansion");
+		MacroUsagesTableHTML(PageHTML, BlueprintDocument.MacroUsages, Symbols);
+	}
+
+	// Event
+	TopicHTML(PageHTML, 2, "EventGraph");
+	EdGraphTableHTML(PageHTML, BlueprintDocument, BlueprintDocument.Events, Symbols, OutPages);
+
+	// Macro
+	TopicHTML(PageHTML, 2, "MacroGraph");
+	EdGraphTableHTML(PageHTML, BlueprintDocument, BlueprintDocument.Macros, Symbols, OutPages);
+
+	// Function
+	TopicHTML(PageHTML, 2, "Functions");
+	EdGraphTableHTML(PageHTML, BlueprintDocument, BlueprintDocument.Functions, Symbols, OutPages);
+
+	// Property
+	TopicHTML(PageHTML, 2, "Property");
+	PropertiesTableHTML(PageHTML, BlueprintDocument.Properties, Symbols);
+
+	OutPages.Add(BlueprintDocument.PageName + TEXT(".html"), MoveTemp(PageHTML));
+}
+
+void UBlueprintToDocUtil::TypePageHTML(FBlueprintToDocHTMLWriter& OutHTML, const FTypeDocument& TypeDocument, const FDocumentSymbolTable& Symbols)
+{
+	// タイトル
+	TopicHTML(OutHTML, 1, TypeDocument.Name);
+	// 説明
+	OutHTML.AppendEscaped(TypeDocument.ToolTips);
+	OutHTML.Append("</br>");
+	// Path
+	TopicHTML(OutHTML, 2, "ContentPath");
+	OutHTML.AppendEscaped(TypeDocument.ContentPath);
+	OutHTML.Append("</br>");
+
+	if(TypeDocument.bIsEnum)
+	{
+		TopicHTML(OutHTML, 2, "Values");
+		OutHTML.Append("<table>\n");
+		OutHTML.Append("<tr><th>Name</th><th>Value</th><th>TootTip</th></tr>\n");
+		for(const FPropertyDocument& MemberDocument : TypeDocument.Members)
+		{
+			OutHTML.Append("<tr>");
+			AddCell(OutHTML, MemberDocument.Name);
+			AddCell(OutHTML, MemberDocument.DefaultValue);
+			AddCell(OutHTML, MemberDocument.ToolTips);
+			OutHTML.Append("</tr>\n");
+		}
+		OutHTML.Append("</table>\n");
+	}
+	else
+	{
+		TopicHTML(OutHTML, 2, "Members");
+		OutHTML.Append("<table>\n");
+		OutHTML.Append("<tr><th>Type</th><th>Name</th><th>DefaultValue</th><th>TootTip</th></tr>\n");
+		for(const FPropertyDocument& MemberDocument : TypeDocument.Members)
+		{
+			OutHTML.Append("<tr>");
+			AddTypeCell(OutHTML, MemberDocument.Type, MemberDocument.TypePath, Symbols);
+			AddCell(OutHTML, MemberDocument.Name);
+			AddCell(OutHTML, MemberDocument.DefaultValue);
+			AddCell(OutHTML, MemberDocument.ToolTips);
+			OutHTML.Append("</tr>\n");
+		}
+		OutHTML.Append("</table>\n");
+	}
+}
+
+void UBlueprintToDocUtil::ReportPagesHTML(FHTMLPages& OutPages, const FDocument& Document)
+{
+	const UBlueprintToDocUserSettings* Settings = GetDefault<UBlueprintToDocUserSettings>();
+
+	// ハード参照の重いブループリント
+	HeavyBlueprintPageHTML(OutPages.Add(TEXT("heavy_blueprints.html")), Document);
+
+	// 実行コストの高いグラフ
+	HotspotPageHTML(OutPages.Add(TEXT("hotspots.html")), Document);
+
+	// レプリケーションの推定バイト数
+	ReplicationPageHTML(OutPages.Add(TEXT("replication.html")), Document);
+
+	// メモリレイアウト
+	MemoryLayoutPageHTML(OutPages.Add(TEXT("memory_layout.html")), Document);
+
+	// TODO
+	TodoPageHTML(OutPages.Add(TEXT("todo.html")), Document);
+
+	// アニメーションブループリントの更新コスト
+	AnimBlueprintPageHTML(OutPages.Add(TEXT("anim_blueprints.html")), Document);
+
+	// ウィジェットブループリントの毎フレームのコスト
+	WidgetBlueprintPageHTML(OutPages.Add(TEXT("widget_blueprints.html")), Document);
+
+	// マクロの展開コスト
+	MacroExpansionPageHTML(OutPages.Add(TEXT("macros.html")), Document);
+
+	// カテゴリごとのプロパティ
+	for (FName CatagoryName : Settings->ListupCategories)
+	{
+		CategoryPageHTML(OutPages.Add(CatagoryName.ToString() + TEXT(".html")), Document, CatagoryName);
+	}
+}
+
+void UBlueprintToDocUtil::GetReportPageNames(TArray<FString>& OutPageNames)
+{
+	// ReportPagesHTML で出力するページと同じ
+	OutPageNames = {
+		TEXT("heavy_blueprints.html"),
+		TEXT("hotspots.html"),
+		TEXT("replication.html"),
+		TEXT("memory_layout.html"),
+		TEXT("todo.html"),
+		TEXT("anim_blueprints.html"),
+		TEXT("widget_blueprints.html"),
+		TEXT("macros.html"),
+	};
+
+	const UBlueprintToDocUserSettings* Settings = GetDefault<UBlueprintToDocUserSettings>();
+	for (FName CatagoryName : Settings->ListupCategories)
+	{
+		OutPageNames.Add(CatagoryName.ToString() + TEXT(".html"));
+	}
+}
+
+void UBlueprintToDocUtil::SaveHTMLPages(const FString& RootPath, const FHTMLPages& Pages)
+{
+	for(const TPair<FString, FBlueprintToDocHTMLWriter>& Page : Pages)
+	{
+		FString Path = RootPath / "blueprint" / Page.Key;
+		if(!Page.Value.SavePage(Path))
+		{
+			UE_LOG(LogBlueprintToDoc, Error, TEXT("Failed Save File:%s"), *Path);
+		}
+	}
+}
+
+void UBlueprintToDocUtil::TopicHTML(FBlueprintToDocHTMLWriter& OutHTML, int32 Level, const FString& Contents)
+{
+	OutHTML.Append("<h");
+	OutHTML.AppendInt(Level);
+	OutHTML.Append(">");
+	OutHTML.AppendEscaped(Contents);
+	OutHTML.Append("</h");
+	OutHTML.AppendInt(Level);
+	OutHTML.Append(">\n");
+}
+
+void UBlueprintToDocUtil::TopicHTML(FBlueprintToDocHTMLWriter& OutHTML, int32 Level, const ANSICHAR* Contents)
+{
+	OutHTML.Append("<h");
+	OutHTML.AppendInt(Level);
+	OutHTML.Append(">");
+	OutHTML.AppendUTF8(Contents, FCStringAnsi::Strlen(Contents));
+	OutHTML.Append("</h");
+	OutHTML.AppendInt(Level);
+	OutHTML.Append(">\n");
+}
+
+
+void UBlueprintToDocUtil::AddCell(FBlueprintToDocHTMLWriter& OutHTML, const FString& Contents)
+{
+	OutHTML.Append("<td>");
+	OutHTML.AppendEscaped(Contents);
+	OutHTML.Append("</td>");
+}
+
+void UBlueprintToDocUtil::AddCell(FBlueprintToDocHTMLWriter& OutHTML, FName Contents)
+{
+	OutHTML.Append("<td>");
+	OutHTML.AppendEscaped(Contents);
+	OutHTML.Append("</td>");
+}
+
+void UBlueprintToDocUtil::AddCell(FBlueprintToDocHTMLWriter& OutHTML, const FBlueprintToDocHTMLWriter& Contents)
+{
+	OutHTML.Append("<td>");
+	OutHTML.Append(Contents);
+	OutHTML.Append("</td>");
+}
+
+void UBlueprintToDocUtil::AddIntCell(FBlueprintToDocHTMLWriter& OutHTML, int64 Value)
+{
+	OutHTML.Append("<td>");
+	OutHTML.AppendInt(Value);
+	OutHTML.Append("</td>");
+}
+
+void UBlueprintToDocUtil::AddLink(FBlueprintToDocHTMLWriter& OutHTML, const FString& FileName, const FString& Label)
+{
+	OutHTML.Append("<a href=\"");
+	OutHTML.Append(FileName);
+	OutHTML.Append("\" target=\"document\">");
+	OutHTML.AppendEscaped(Label);
+	OutHTML.Append("</a>");
+}
+
+void UBlueprintToDocUtil::AddLinkCell(FBlueprintToDocHTMLWriter& OutHTML, const FString& FileName, const FString& Label)
+{
+	OutHTML.Append("<td>");
+	AddLink(OutHTML, FileName, Label);
+	OutHTML.Append("</td>");
+}
+
+void UBlueprintToDocUtil::AddType(FBlueprintToDocHTMLWriter& OutHTML, FName Type, FName TypePath, const FDocumentSymbolTable& Symbols)
+{
+	if(const FString* PageName = Symbols.FindPageName(TypePath))
+	{
+		OutHTML.Append("<a href=\"");
+		OutHTML.Append(*PageName);
+		OutHTML.Append(".html\" target=\"document\">");
+		OutHTML.AppendEscaped(Type);
+		OutHTML.Append("</a>");
+	}
+	else
+	{
+		OutHTML.AppendEscaped(Type);
+	}
+}
+
+void UBlueprintToDocUtil::AddTypeCell(FBlueprintToDocHTMLWriter& OutHTML, FName Type, FName TypePath, const FDocumentSymbolTable& Symbols)
+{
+	OutHTML.Append("<td>");
+	AddType(OutHTML, Type, TypePath, Symbols);
+	OutHTML.Append("</td>");
+}
+
+void UBlueprintToDocUtil::AddLine(FBlueprintToDocHTMLWriter& OutHTML, bool Result, const FString& AddString)
+{
+	if(Result)
+	{
+		OutHTML.Append(AddString);
+		OutHTML.Append("</br>\n");
+	}
+}
+
+FString UBlueprintToDocUtil::EdGraphHTMLFileName(const FBlueprintDocument& BlueprintDocument, const FEdGraphDocument& EdGraphDocument)
+{
+	// アセット名とグラフ名には '.' を使えないので、他のページ名と重複しない
+	return FString::Printf(TEXT("%s.%s.html"), *BlueprintDocument.PageName, *(EdGraphDocument.GraphName.ToString().Replace(TEXT(" "), TEXT(""))));
+}
+
+void UBlueprintToDocUtil::EdGraphTableHTML(FBlueprintToDocHTMLWriter& OutHTML, const FBlueprintDocument& BlueprintDocument, const TArray<FEdGraphDocument>& EdGraphDocuments, const FDocumentSymbolTable& Symbols, FHTMLPages& OutPages)
+{
+	static const ANSICHAR PinTableHeader[] = "<table>\n<tr><th>Type</th><th>Name</th><th>TootTip</th></tr>\n";
+	static const ANSICHAR TableFooter[] = "</table>\n";
+
+	// テーブルのヘッダー部分の追加
+	OutHTML.Append("<table>\n");
+	OutHTML.Append("<tr>");
+	OutHTML.Append("<th>Category</th>");
+	OutHTML.Append("<th>Access</th>");
+	OutHTML.Append("<th>Name</th>");
+	OutHTML.Append("<th>TootTip</th>");
+	OutHTML.Append("<th>Input</th>");
+	OutHTML.Append("<th>Output</th>");
+	OutHTML.Append("<th>Net</th>");
+	OutHTML.Append("<th>Flag</th>");
+	OutHTML.Append("</tr>\n");
+
+	for(const FEdGraphDocument& EdGraph : EdGraphDocuments)
+	{
+		FString HTMLFileName = EdGraphHTMLFileName(BlueprintDocument, EdGraph);
+
+		FBlueprintToDocHTMLWriter FunctionHTML;
+		FBlueprintToDocHTMLWriter FunctionInputHTML;
+		FBlueprintToDocHTMLWriter FunctionOutputHTML;
+		FBlueprintToDocHTMLWriter AccessHTML;
+		FBlueprintToDocHTMLWriter NetHTML;
+		FBlueprintToDocHTMLWriter FlagHTML;
+
+
+		TopicHTML(FunctionHTML, 1, EdGraph.Name);
+		FunctionHTML.AppendEscaped(EdGraph.ToolTips);
+		FunctionHTML.Append("</br>");
+		TopicHTML(FunctionHTML, 2, "Category");
+		FunctionHTML.AppendEscaped(EdGraph.Category);
+		FunctionHTML.Append("</br>");
+
+		// ノードの配置から描画したグラフ
+		if(EdGraph.NodeLayouts.Num() > 0)
+		{
+			TopicHTML(FunctionHTML, 2, "Graph");
+			FBlueprintToDocGraphSVG::Append(FunctionHTML, EdGraph);
+		}
+
+		if(EdGraph.TodoList.Num() > 0)
+		{
+			TopicHTML(FunctionHTML, 2, "Todo");
+			for(const FString& Todo : EdGraph.TodoList)
+			{
+				FunctionHTML.AppendEscaped(Todo);
+				FunctionHTML.Append("</br>");
+			}
+		}
+
+		// アクセス、ネット、FunctionFlag
+		FBlueprintToDocFlagLabels::AppendFragment(AccessHTML, FBlueprintToDocFlagLabels::EColumn::FunctionAccess, EdGraph.Flag);
+		FBlueprintToDocFlagLabels::AppendFragment(NetHTML, FBlueprintToDocFlagLabels::EColumn::FunctionNet, EdGraph.Flag);
+		FBlueprintToDocFlagLabels::AppendFragment(FlagHTML, FBlueprintToDocFlagLabels::EColumn::FunctionFlag, EdGraph.Flag);
+
+
+		if(!AccessHTML.IsEmpty())
+		{
+			TopicHTML(FunctionHTML, 2, "Access");
+			FunctionHTML.Append(AccessHTML);
+		}
+		if(!NetHTML.IsEmpty())
+		{
+			TopicHTML(FunctionHTML, 2, "Net");
+			FunctionHTML.Append(NetHTML);
+		}
+		if(!FlagHTML.IsEmpty())
+		{
+			TopicHTML(FunctionHTML, 2, "FunctionFlag");
+			FunctionHTML.Append(FlagHTML);
+		}
+
+		// インプットピン
+		TopicHTML(FunctionHTML, 2, "Input");
+		FunctionHTML.Append(PinTableHeader);
+		for(const FEdGraphPinDocument& PinDocument : EdGraph.Input)
+		{
+			// 関数ドキュメント用
+			FunctionHTML.Append("<tr>");
+			AddTypeCell(FunctionHTML, PinDocument.Type, PinDocument.TypePath, Symbols);
+			AddCell(FunctionHTML, PinDocument.Name);
+			AddCell(FunctionHTML, PinDocument.ToolTips);
+			FunctionHTML.Append("</tr>");
+
+			// ブループリントドキュメント用
+			FunctionInputHTML.Append("<b>");
+			AddType(FunctionInputHTML, PinDocument.Type, PinDocument.TypePath, Symbols);
+			FunctionInputHTML.Append(u8"</b>　<i>");
+			FunctionInputHTML.AppendEscaped(PinDocument.Name);
+			FunctionInputHTML.Append("</i></br>");
+			FunctionInputHTML.AppendEscaped(PinDocument.ToolTips);
+			FunctionInputHTML.Append("</br>");
+		}
+		FunctionHTML.Append(TableFooter);
+
+		// アウトプットピン
+		TopicHTML(FunctionHTML, 2, "Output");
+		FunctionHTML.Append(PinTableHeader);
+		for(const FEdGraphPinDocument& PinDocument : EdGraph.Output)
+		{
+			// 関数ドキュメント用
+			FunctionHTML.Append("<tr>");
+			AddTypeCell(FunctionHTML, PinDocument.Type, PinDocument.TypePath, Symbols);
+			AddCell(FunctionHTML, PinDocument.Name);
+			AddCell(FunctionHTML, PinDocument.ToolTips);
+			FunctionHTML.Append("</tr>");
+
+			// ブループリントドキュメント用
+			FunctionOutputHTML.Append("<b>");
+			AddType(FunctionOutputHTML, PinDocument.Type, PinDocument.TypePath, Symbols);
+			FunctionOutputHTML.Append(u8"</b>　<i>");
+			FunctionOutputHTML.AppendEscaped(PinDocument.Name);
+			FunctionOutputHTML.Append("</i></br>");
+			FunctionOutputHTML.AppendEscaped(PinDocument.ToolTips);
+			FunctionOutputHTML.Append("</br>");
+		}
+		FunctionHTML.Append(TableFooter);
+
+
+		// 関数ドキュメント
+		OutPages.Add(HTMLFileName, MoveTemp(FunctionHTML));
+
+		OutHTML.Append("<tr>");
+		AddCell(OutHTML, EdGraph.Category);
+		AddCell(OutHTML, AccessHTML);
+		AddLinkCell(OutHTML, HTMLFileName, EdGraph.Name);
+		OutHTML.Append("\n");
+		AddCell(OutHTML, EdGraph.ToolTips);
+		AddCell(OutHTML, FunctionInputHTML);
+		AddCell(OutHTML, FunctionOutputHTML);
+		AddCell(OutHTML, NetHTML);
+		AddCell(OutHTML, FlagHTML);
+		OutHTML.Append("</tr>\n");
+	}
+	OutHTML.Append("</table>\n");
+}
+
+
+
+void UBlueprintToDocUtil::ComponentsTableHTML(FBlueprintToDocHTMLWriter& OutHTML, const TArray<FComponentDocument>& ComponentDocuments, const FDocumentSymbolTable& Symbols)
+{
+	OutHTML.Append("<table>\n");
+	OutHTML.Append("<tr>");
+	OutHTML.Append("<th>Name</th>");
+	OutHTML.Append("<th>Class</th>");
+	OutHTML.Append("<th>AttachParent</th>");
+	OutHTML.Append("<th>Tick</th>");
+	OutHTML.Append("<th>Collision</th>");
+	OutHTML.Append("</tr>\n");
+
+	for(const FComponentDocument& ComponentDocument : ComponentDocuments)
+	{
+		// ツリーの深さで字下げし、継承したものは斜体
+		FBlueprintToDocHTMLWriter NameHTML;
+		for(int32 Depth = 0; Depth < ComponentDocument.Depth; ++Depth)
+		{
+			NameHTML.Append("&nbsp;&nbsp;");
+		}
+		if(ComponentDocument.bInherited)
+		{
+			NameHTML.Append("<i>");
+			NameHTML.AppendEscaped(ComponentDocument.Name);
+			NameHTML.Append("</i>");
+		}
+		else
+		{
+			NameHTML.AppendEscaped(ComponentDocument.Name);
+		}
+
+		FBlueprintToDocHTMLWriter AttachHTML;
+		AttachHTML.AppendEscaped(ComponentDocument.AttachParent);
+		if(!ComponentDocument.AttachSocket.IsNone())
+		{
+			AttachHTML.Append(" / ");
+			AttachHTML.AppendEscaped(ComponentDocument.AttachSocket);
+		}
+
+		FBlueprintToDocHTMLWriter TickHTML;
+		if(ComponentDocument.bCanEverTick)
+		{
+			TickHTML.Append("Tick");
+			if(!ComponentDocument.bStartWithTickEnabled)
+			{
+				TickHTML.Append(" (StartDisabled)");
+			}
+
+			if(ComponentDocument.TickInterval > 0.0f)
+			{
+				TickHTML.Append(FString::Printf(TEXT(" / %.2fs"), ComponentDocument.TickInterval));
+			}
+		}
+
+		FBlueprintToDocHTMLWriter CollisionHTML;
+		if(ComponentDocument.bIsPrimitive)
+		{
+			const ANSICHAR* Label = GetCollisionEnabledLabel(ComponentDocument.CollisionEnabled);
+			CollisionHTML.AppendEscaped(ComponentDocument.CollisionProfile);
+			CollisionHTML.Append("</br>\n");
+			CollisionHTML.AppendUTF8(Label, FCStringAnsi::Strlen(Label));
+			if(ComponentDocument.bGenerateOverlapEvents)
+			{
+				CollisionHTML.Append(" / Overlap");
+			}
+		}
+
+		OutHTML.Append("<tr>");
+		AddCell(OutHTML, NameHTML);
+		AddTypeCell(OutHTML, ComponentDocument.ComponentClass, ComponentDocument.ClassPath, Symbols);
+		AddCell(OutHTML, AttachHTML);
+		AddCell(OutHTML, TickHTML);
+		AddCell(OutHTML, CollisionHTML);
+		OutHTML.Append("</tr>\n");
+	}
+	OutHTML.Append("</table>\n");
+}
 
-	// 条件にあったアセットを取得
-	TArray<FAssetData> ShowAssetData;
-	if(!AssetRegistry.GetAssets(Filter,ShowAssetData))
+void UBlueprintToDocUtil::AnimGraphTableHTML(FBlueprintToDocHTMLWriter& OutHTML, const FBlueprintDocument& BlueprintDocument)
+{
+	// 更新するスレッド
+	if(BlueprintDocument.bUseMultiThreadedAnimationUpdate)
 	{
-		return;
+		OutHTML.Append("Update WorkerThread");
 	}
+	else
+	{
+		OutHTML.Append("Update GameThread");
+	}
+	OutHTML.Append("</br>\n");
 
-	// 取得したアセットをドキュメント化
-	for(auto It = ShowAssetData.CreateConstIterator(); It; ++It)
+	// ステート
+	if(BlueprintDocument.AnimStates.Num() > 0)
 	{
-		// エンジンソースは省く
-		FString BlueprintPackagePath = It->PackagePath.ToString();
-		if(BlueprintPackagePath.Find(TEXT("/Engine/")) != -1)
+		OutHTML.Append("<table>\n");
+		OutHTML.Append("<tr>");
+		OutHTML.Append("<th>StateMachine</th>");
+		OutHTML.Append("<th>State</th>");
+		OutHTML.Append("<th>Nodes</th>");
+		OutHTML.Append("<th>SlowPathNodes</th>");
+		OutHTML.Append("<th>Transitions</th>");
+		OutHTML.Append("</tr>\n");
+
+		for(const FAnimStateDocument& AnimStateDocument : BlueprintDocument.AnimStates)
 		{
-			continue;
+			OutHTML.Append("<tr>");
+			AddCell(OutHTML, AnimStateDocument.StateMachine);
+			AddCell(OutHTML, AnimStateDocument.Name);
+			AddIntCell(OutHTML, AnimStateDocument.NodeCount);
+			AddIntCell(OutHTML, AnimStateDocument.SlowPathNodeCount);
+			AddIntCell(OutHTML, AnimStateDocument.TransitionCount);
+			OutHTML.Append("</tr>\n");
 		}
+		OutHTML.Append("</table>\n");
+	}
 
-		// アセットをUBlueprintにキャスト
-		UBlueprint* BluprintClass = Cast<UBlueprint>(It->GetAsset());
-		if(BluprintClass == nullptr)
+	// 入力が接続されたノードだけ並べる
+	OutHTML.Append("<table>\n");
+	OutHTML.Append("<tr>");
+	OutHTML.Append("<th>Graph</th>");
+	OutHTML.Append("<th>Node</th>");
+	OutHTML.Append("<th>BoundPins</th>");
+	OutHTML.Append("<th>SlowPathPins</th>");
+	OutHTML.Append("<th>ThreadUnsafeCalls</th>");
+	OutHTML.Append("</tr>\n");
+
+	for(const FAnimNodeDocument& AnimNodeDocument : BlueprintDocument.AnimNodes)
+	{
+		if(AnimNodeDocument.BoundPinCount == 0)
 		{
 			continue;
 		}
 
-		FBlueprintDocument BlueprintDocument;
-
-		// BlueprintName
-		BlueprintDocument.Name = It->AssetName.ToString();
-		// ToolTips
-		BlueprintDocument.ToolTips = BluprintClass->GeneratedClass->GetMetaData(TEXT("ToolTip"));
-		// Path
-		BlueprintDocument.ContentPath = BlueprintPackagePath;
-
-		UClass* const BPClass = BluprintClass->GeneratedClass;
-		if(BPClass)
+		FBlueprintToDocHTMLWriter CallsHTML;
+		for(const FString& Call : AnimNodeDocument.ThreadUnsafeCalls)
 		{
-			// 親クラス名
-			BlueprintDocument.ParentName = BPClass->GetSuperStruct()->GetName();
-
-			// Event
-			MakeEdGraphDocument(BlueprintDocument.Events, BluprintClass, BluprintClass->EventGraphs);
-
-			// Macro
-			MakeEdGraphDocument(BlueprintDocument.Macros, BluprintClass, BluprintClass->MacroGraphs);
-
-			// Function
-			MakeEdGraphDocument(BlueprintDocument.Functions, BluprintClass, BluprintClass->FunctionGraphs);
-
-			// Propery
-			for(TFieldIterator<UProperty> PropIt(BPClass); PropIt; ++PropIt)
-			{
-				UProperty* Property = *PropIt;
-
-				// エディタ上で作られたものだけリストに
-				if(PropIt->GetFullGroupName(true).Right(2) == TEXT("_C"))
-				{
-					FPropertyDocument PropertyDocument;
+			CallsHTML.AppendEscaped(Call);
+			CallsHTML.Append("</br>\n");
+		}
 
-					if(PropertyDocument.Name.IsEmpty())
-					{
-						PropertyDocument.Name = Property->GetName();
-					}
+		OutHTML.Append("<tr>");
+		AddCell(OutHTML, AnimNodeDocument.GraphPath);
+		AddCell(OutHTML, AnimNodeDocument.Title);
+		AddIntCell(OutHTML, AnimNodeDocument.BoundPinCount);
+		AddIntCell(OutHTML, AnimNodeDocument.SlowPathPinCount);
+		AddCell(OutHTML, CallsHTML);
+		OutHTML.Append("</tr>\n");
+	}
+	OutHTML.Append("</table>\n");
+}
 
-					//プロパティの型をキャストして識別する
-					UStructProperty* StructProperty = Cast<UStructProperty>(*PropIt);
-					UObjectProperty* ObjectProperty = Cast<UObjectProperty>(*PropIt);
-					if(StructProperty)
-					{
-						PropertyDocument.Type = StructProperty->Struct->GetName();
-					}
-					else if(ObjectProperty)
-					{
-						PropertyDocument.Type = ObjectProperty->PropertyClass->GetName();
-					}
-					else
-					{
-						PropertyDocument.Type = PropIt->GetClass()->GetName().Replace(TEXT("Property"), TEXT(""));
-					}
+void UBlueprintToDocUtil::WidgetTableHTML(FBlueprintToDocHTMLWriter& OutHTML, const FBlueprintDocument& BlueprintDocument)
+{
+	// 階層
+	OutHTML.Append("Widgets ");
+	OutHTML.AppendInt(BlueprintDocument.WidgetCount);
+	OutHTML.Append(" / Depth ");
+	OutHTML.AppendInt(BlueprintDocument.WidgetTreeDepth);
+	OutHTML.Append(" / Volatile ");
+	OutHTML.AppendInt(BlueprintDocument.VolatileWidgetCount);
+	OutHTML.Append(" / InvalidationBox ");
+	OutHTML.AppendInt(BlueprintDocument.InvalidationBoxCount);
+	OutHTML.Append(" / RetainerBox ");
+	OutHTML.AppendInt(BlueprintDocument.RetainerBoxCount);
+	OutHTML.Append("</br>\n");
+
+	// Tick
+	for(const FString& TickOverride : BlueprintDocument.WidgetTickOverrides)
+	{
+		OutHTML.Append("Tick ");
+		OutHTML.AppendEscaped(TickOverride);
+		OutHTML.Append("</br>\n");
+	}
 
-					PropertyDocument.Category = Property->GetMetaData(TEXT("Category")).Replace(TEXT("|"), TEXT(" - "));
-					PropertyDocument.ToolTips = Property->GetMetaData(TEXT("ToolTip"));
-					
-					PropertyDocument.PropertyFlg = Property->GetPropertyFlags();
-					PropertyDocument.LifetimeCondition = Property->GetBlueprintReplicationCondition();
+	// バインド(関数はグラフのページへのリンク)
+	if(BlueprintDocument.WidgetBindings.Num() == 0)
+	{
+		return;
+	}
+	OutHTML.Append("<table>\n");
+	OutHTML.Append("<tr>");
+	OutHTML.Append("<th>Widget</th>");
+	OutHTML.Append("<th>Property</th>");
+	OutHTML.Append("<th>Binding</th>");
+	OutHTML.Append("<th>Nodes</th>");
+	OutHTML.Append("</tr>\n");
+
+	for(const FWidgetBindingDocument& BindingDocument : BlueprintDocument.WidgetBindings)
+	{
+		const FEdGraphDocument* Function = BindingDocument.FunctionName.IsNone() ? nullptr : BlueprintDocument.Functions.FindByPredicate([&BindingDocument](const FEdGraphDocument& EdGraph)
+		{
+			return EdGraph.GraphName == BindingDocument.FunctionName;
+		});
 
-					BlueprintDocument.Properties.Add(PropertyDocument);
-				}
-			}
+		OutHTML.Append("<tr>");
+		AddCell(OutHTML, BindingDocument.Widget);
+		AddCell(OutHTML, BindingDocument.Property);
+		if(Function != nullptr)
+		{
+			AddLinkCell(OutHTML, EdGraphHTMLFileName(BlueprintDocument, *Function), Function->Name);
+			AddIntCell(OutHTML, Function->NodeCount);
+		}
+		else
+		{
+			AddCell(OutHTML, BindingDocument.FunctionName.IsNone() ? BindingDocument.SourcePath : BindingDocument.FunctionName.ToString());
+			AddCell(OutHTML, FString());
 		}
-		Document.Blueprints.Add(BlueprintDocument);
+		OutHTML.Append("</tr>\n");
 	}
+	OutHTML.Append("</table>\n");
+}
 
-	//HTMLへ出力
-	DocumentToHTML(Document);
-
-	// カテゴリごとのプロパティ
-	for (FName CatagoryName : Settings->ListupCategories)
+void UBlueprintToDocUtil::MacroUsagesTableHTML(FBlueprintToDocHTMLWriter& OutHTML, const TArray<FMacroUsageDocument>& MacroUsages, const FDocumentSymbolTable& Symbols)
+{
+	OutHTML.Append("<table>\n");
+	OutHTML.Append("<tr>");
+	OutHTML.Append("<th>Macro</th>");
+	OutHTML.Append("<th>Library</th>");
+	OutHTML.Append("<th>Instances</th>");
+	OutHTML.Append("<th>ExpandedNodes</th>");
+	OutHTML.Append("<th>TotalNodes</th>");
+	OutHTML.Append("</tr>\n");
+
+	for(const FMacroUsageDocument& MacroUsage : MacroUsages)
 	{
-		CategoryPageHTML(Document, CatagoryName);
+		OutHTML.Append("<tr>");
+		AddCell(OutHTML, MacroUsage.Name);
+		AddTypeCell(OutHTML, MacroUsage.Library, MacroUsage.LibraryPath, Symbols);
+		AddIntCell(OutHTML, MacroUsage.InstanceCount);
+		AddIntCell(OutHTML, MacroUsage.ExpandedNodeCount);
+		AddIntCell(OutHTML, MacroUsage.InstanceCount * MacroUsage.ExpandedNodeCount);
+		OutHTML.Append("</tr>\n");
 	}
+	OutHTML.Append("</table>\n");
 }
 
+void UBlueprintToDocUtil::PropertiesTableHTML(FBlueprintToDocHTMLWriter& OutHTML, const TArray<FPropertyDocument>& PropertiesDocuments, const FDocumentSymbolTable& Symbols)
+{
+	OutHTML.Append("<table>\n");
+	OutHTML.Append("<tr>");
+	OutHTML.Append("<th>Category</th>");
+	OutHTML.Append("<th>Access</th>");
+	OutHTML.Append("<th>Type</th>");
+	OutHTML.Append("<th>Name</th>");
+	OutHTML.Append("<th>TootTip</th>");
+	OutHTML.Append("<th>Net</th>");
+	OutHTML.Append("<th>Flag</th>");
+	OutHTML.Append("</tr>\n");
+
+	for(const FPropertyDocument& PropertyDocument : PropertiesDocuments)
+	{
+		FBlueprintToDocHTMLWriter AccessHTML;
+		FBlueprintToDocHTMLWriter NetHTML;
+		FBlueprintToDocHTMLWriter FlagHTML;
+
+		// 各プロパティフラグの情報を文字列化
+		FBlueprintToDocFlagLabels::AppendFragment(AccessHTML, FBlueprintToDocFlagLabels::EColumn::PropertyAccess, PropertyDocument.PropertyFlg);
+		FBlueprintToDocFlagLabels::AppendFragment(FlagHTML, FBlueprintToDocFlagLabels::EColumn::PropertyFlag, PropertyDocument.PropertyFlg);
+		// Net(フラグとLifetime)
+		FBlueprintToDocFlagLabels::AppendPropertyNetFragment(NetHTML, PropertyDocument.PropertyFlg, PropertyDocument.LifetimeCondition);
+		// 推定バイト数はプロパティごとに違うのでキャッシュしない
+		if((PropertyDocument.PropertyFlg & CPF_Net) != 0)
+		{
+			NetHTML.Append("~");
+			NetHTML.AppendInt(PropertyDocument.ReplicatedSize);
+			NetHTML.Append(" bytes</br>\n");
+		}
+
+		OutHTML.Append("<tr>");
+		AddCell(OutHTML, PropertyDocument.Category);
+		AddCell(OutHTML, AccessHTML);
+		AddTypeCell(OutHTML, PropertyDocument.Type, PropertyDocument.TypePath, Symbols);
+		AddCell(OutHTML, PropertyDocument.Name);
+		AddCell(OutHTML, PropertyDocument.ToolTips);
+		AddCell(OutHTML, NetHTML);
+		AddCell(OutHTML, FlagHTML);
+		OutHTML.Append("</tr>\n");
+	}
+	OutHTML.Append("</table>\n");
+}
 
-void UBlueprintToDocUtil::MakeEdGraphDocument(TArray<FEdGraphDocument>& OutEdGraphDocument, class UBlueprint* Blueprint, const TArray<UEdGraph*>& EdGraphs)
+void UBlueprintToDocUtil::CategoryPageHTML(FBlueprintToDocHTMLWriter& OutHTML, const FDocument& Document, FName Category)
 {
-	UClass* const BPClass = Blueprint->GeneratedClass;
-	FString BlueprintNameString = BPClass->GetName();
+	// カテゴリ名ごとに一度だけ文字列を調べる
+	const FString CategoryString = Category.ToString();
+	TMap<FName, bool> CategoryMatches;
 
-	for(UEdGraph* graph : EdGraphs)
+	// ブループリント(プロパティは整形時にソート済み)
+	for (const FBlueprintDocument& BlueprintDocument : Document.Blueprints)
 	{
-		FEdGraphDocument AddEdGraphDocument;
+		FBlueprintToDocHTMLWriter RowHTML;
 
-		AddEdGraphDocument.Parent = BlueprintNameString;
-
-		UFunction* CheckFunction = BPClass->GetDefaultObject()->FindFunction(graph->GetFName());
-		if(CheckFunction != nullptr)
+		for (const FPropertyDocument& PropertyDocument : BlueprintDocument.Properties)
 		{
-			AddEdGraphDocument.Name = CheckFunction->GetMetaData(FBlueprintMetadata::MD_DisplayName);
-			if(AddEdGraphDocument.Name.IsEmpty())
+			bool* bMatch = CategoryMatches.Find(PropertyDocument.Category);
+			if (bMatch == nullptr)
 			{
-				AddEdGraphDocument.Name = graph->GetName();
+				bMatch = &CategoryMatches.Add(PropertyDocument.Category, NameToString(PropertyDocument.Category).Find(CategoryString) != INDEX_NONE);
 			}
-			AddEdGraphDocument.Category = CheckFunction->GetMetaData(TEXT("Category")).Replace(TEXT("|"), TEXT(" - "));
-			AddEdGraphDocument.ToolTips = CheckFunction->GetMetaData(TEXT("ToolTip"));
-			AddEdGraphDocument.Flag = (uint64)CheckFunction->FunctionFlags;
-		}
-		else
-		{
-			FGraphDisplayInfo DisplayInfo;
-			graph->GetSchema()->GetGraphDisplayInformation(*graph, DisplayInfo);
-
-			AddEdGraphDocument.Name = DisplayInfo.DisplayName.ToString();
-			if(AddEdGraphDocument.Name.IsEmpty())
+			if (*bMatch)
 			{
-				AddEdGraphDocument.Name = graph->GetName();
+				RowHTML.Append("<tr>");
+				AddCell(RowHTML, PropertyDocument.Name);
+				AddTypeCell(RowHTML, PropertyDocument.Type, PropertyDocument.TypePath, Document.GetSymbols());
+				AddCell(RowHTML, PropertyDocument.Category);
+				AddCell(RowHTML, PropertyDocument.ToolTips);
+				RowHTML.Append("</tr>\n");
 			}
-
-			AddEdGraphDocument.ToolTips = DisplayInfo.Tooltip.ToString();
 		}
-
-		// 入出力ピン
-		for(UEdGraphNode* Node : graph->Nodes)
+		if (!RowHTML.IsEmpty())
 		{
-			bool IsFunctionEntry = (Node->GetName().Find(TEXT("FunctionEntry")) != -1);
-			bool IsFunctionResult = (Node->GetName().Find(TEXT("FunctionResult")) != -1);
+			OutHTML.Append("<h2>");
+			AddLink(OutHTML, BlueprintDocument.PageName + TEXT(".html"), BlueprintDocument.Name);
+			OutHTML.Append("</br>\n</h2>\n");
+
+			OutHTML.Append("<table>\n");
+			OutHTML.Append("<tr>");
+			OutHTML.Append("<th>Name</th>");
+			OutHTML.Append("<th>Type</th>");
+			OutHTML.Append("<th>Category</th>");
+			OutHTML.Append("<th>TootTip</th>");
+			OutHTML.Append("</tr>\n");
+			OutHTML.Append(RowHTML);
+			OutHTML.Append("</table>");
+		}
+	}
+}
 
-			if(IsFunctionEntry || IsFunctionResult)
-			{
-				TArray<UEdGraphPin*> AllPins = Node->GetAllPins();
-				// エントリーノードにコメントがついている場合はToolTipsに追加
-				if(IsFunctionEntry && !Node->NodeComment.IsEmpty())
-				{
-					AddEdGraphDocument.ToolTips += Node->NodeComment;
-				}
+void UBlueprintToDocUtil::HeavyBlueprintPageHTML(FBlueprintToDocHTMLWriter& OutHTML, const FDocument& Document)
+{
+	// 推定メモリサイズの大きい順(ドキュメントはコピーせずにポインタを並べ替える)
+	TArray<const FBlueprintDocument*> SortedBlueprints;
+	SortedBlueprints.Reserve(Document.Blueprints.Num());
+	for(const FBlueprintDocument& BlueprintDocument : Document.Blueprints)
+	{
+		SortedBlueprints.Add(&BlueprintDocument);
+	}
+	SortedBlueprints.Sort(FHardReferenceSorter());
+
+	TopicHTML(OutHTML, 1, "HeavyBlueprints");
+
+	OutHTML.Append("<table>\n");
+	OutHTML.Append("<tr>");
+	OutHTML.Append("<th>Rank</th>");
+	OutHTML.Append("<th>Name</th>");
+	OutHTML.Append("<th>ContentPath</th>");
+	OutHTML.Append("<th>Packages</th>");
+	OutHTML.Append("<th>Disk</th>");
+	OutHTML.Append("<th>Memory</th>");
+	OutHTML.Append("</tr>\n");
+
+	int32 Rank = 1;
+	for(const FBlueprintDocument* SortedBlueprint : SortedBlueprints)
+	{
+		const FBlueprintDocument& BlueprintDocument = *SortedBlueprint;
+		OutHTML.Append("<tr>");
+		AddIntCell(OutHTML, Rank++);
+		AddLinkCell(OutHTML, BlueprintDocument.PageName + TEXT(".html"), BlueprintDocument.Name);
+		AddCell(OutHTML, BlueprintDocument.ContentPath);
+		AddIntCell(OutHTML, BlueprintDocument.HardReferenceCount);
+		AddCell(OutHTML, SizeToString(BlueprintDocument.HardReferenceDiskSize));
+		AddCell(OutHTML, SizeToString(BlueprintDocument.HardReferenceMemorySize));
+		OutHTML.Append("</tr>\n");
+	}
+	OutHTML.Append("</table>\n");
 
-				for(UEdGraphPin* Pin : AllPins)
-				{
-					FEdGraphPinDocument PinDocument;
-					PinDocument.Name = Pin->PinName.ToString();
-					if(Pin->PinType.PinSubCategoryObject != nullptr)
-					{
-						PinDocument.Type = Pin->PinType.PinSubCategoryObject->GetName();
-					}
-					else
-					{
-						PinDocument.Type = Pin->PinType.PinCategory.ToString();
-					}
-					PinDocument.DefaultValue = Pin->GetDefaultAsString();
-					PinDocument.ToolTips = Pin->PinToolTip;
+}
 
-					if(IsFunctionEntry)
-					{
-						AddEdGraphDocument.Input.Add(PinDocument.Name, PinDocument);
-					}
-					else if(IsFunctionResult)
-					{
-						AddEdGraphDocument.Output.Add(PinDocument.Name,PinDocument);
-					}
-				}
+void UBlueprintToDocUtil::HotspotPageHTML(FBlueprintToDocHTMLWriter& OutHTML, const FDocument& Document)
+{
+	struct FHotspot
+	{
+		const FBlueprintDocument* Blueprint;
+		const FEdGraphDocument* EdGraph;
+		int32 Score;
+	};
+
+	// 全グラフを集計
+	TArray<FHotspot> Hotspots;
+	for(const FBlueprintDocument& BlueprintDocument : Document.Blueprints)
+	{
+		for(const TArray<FEdGraphDocument>* EdGraphs : { &BlueprintDocument.Events, &BlueprintDocument.Macros, &BlueprintDocument.Functions })
+		{
+			for(const FEdGraphDocument& EdGraph : *EdGraphs)
+			{
+				Hotspots.Add({ &BlueprintDocument, &EdGraph, GetHotspotScore(EdGraph) });
 			}
 		}
-		OutEdGraphDocument.Add(AddEdGraphDocument);
 	}
+	Hotspots.Sort([](const FHotspot& A, const FHotspot& B)
+	{
+		if(A.Score != B.Score)
+		{
+			return A.Score > B.Score;
+		}
+		return A.EdGraph->NodeCount > B.EdGraph->NodeCount;
+	});
+
+	TopicHTML(OutHTML, 1, "Hotspots");
+
+	OutHTML.Append("<table>\n");
+	OutHTML.Append("<tr>");
+	OutHTML.Append("<th>Rank</th>");
+	OutHTML.Append("<th>Blueprint</th>");
+	OutHTML.Append("<th>Graph</th>");
+	OutHTML.Append("<th>Score</th>");
+	OutHTML.Append("<th>Nodes</th>");
+	OutHTML.Append("<th>HotNodes</th>");
+	OutHTML.Append("<th>HotLoops</th>");
+	OutHTML.Append("<th>HotCasts</th>");
+	OutHTML.Append("<th>HotActorSearch</th>");
+	OutHTML.Append("<th>PureReevaluation</th>");
+	OutHTML.Append("</tr>\n");
+
+	int32 Rank = 1;
+	for(const FHotspot& Hotspot : Hotspots)
+	{
+		const FEdGraphDocument& EdGraph = *Hotspot.EdGraph;
+		OutHTML.Append("<tr>");
+		AddIntCell(OutHTML, Rank++);
+		AddLinkCell(OutHTML, Hotspot.Blueprint->PageName + TEXT(".html"), Hotspot.Blueprint->Name);
+		AddLinkCell(OutHTML, EdGraphHTMLFileName(*Hotspot.Blueprint, EdGraph), EdGraph.Name);
+		AddIntCell(OutHTML, Hotspot.Score);
+		AddIntCell(OutHTML, EdGraph.NodeCount);
+		AddIntCell(OutHTML, EdGraph.HotNodeCount);
+		AddIntCell(OutHTML, EdGraph.HotLoopCount);
+		AddIntCell(OutHTML, EdGraph.HotCastCount);
+		AddIntCell(OutHTML, EdGraph.HotActorSearchCount);
+		AddIntCell(OutHTML, EdGraph.PureReevaluationCount);
+		OutHTML.Append("</tr>\n");
+	}
+	OutHTML.Append("</table>\n");
+
 }
 
-void UBlueprintToDocUtil::DocumentToHTML(FDocument& Document)
+void UBlueprintToDocUtil::ReplicationPageHTML(FBlueprintToDocHTMLWriter& OutHTML, const FDocument& Document)
 {
 	const UBlueprintToDocUserSettings* Settings = GetDefault<UBlueprintToDocUserSettings>();
 
-	//目次ページ
-	FString TOCOutput;
-	FString LastTOCPath;
-	Document.Blueprints.Sort(FBlueprintSorter());
-	
-	// カテゴリ プロパティのページのリンクは先頭に
-	for (FName CatagoryName : Settings->ListupCategories)
+	// レプリケーションするアクターのみ(ドキュメントはコピーせずにポインタを並べ替える)
+	TArray<const FBlueprintDocument*> SortedBlueprints;
+	for(const FBlueprintDocument& BlueprintDocument : Document.Blueprints)
 	{
-		TOCOutput += FString::Printf(TEXT("<a href=\"%s.html\" target=\"document\">%s</a></br>\n"), *(CatagoryName.ToString()), *(CatagoryName.ToString()));
+		if(BlueprintDocument.bIsActor && (BlueprintDocument.ReplicatedSize > 0 || BlueprintDocument.RPCCount > 0))
+		{
+			SortedBlueprints.Add(&BlueprintDocument);
+		}
 	}
-
-	// ブループリント
-	for(FBlueprintDocument BlueprintDocument : Document.Blueprints)
+	SortedBlueprints.Sort(FReplicationSorter());
+
+	TopicHTML(OutHTML, 1, "Replication");
+
+	OutHTML.Append("<table>\n");
+	OutHTML.Append("<tr>");
+	OutHTML.Append("<th>Name</th>");
+	OutHTML.Append("<th>ContentPath</th>");
+	OutHTML.Append("<th>Properties</th>");
+	OutHTML.Append("<th>Payload</th>");
+	OutHTML.Append("<th>AlwaysReplicated</th>");
+	OutHTML.Append("<th>Condition</th>");
+	OutHTML.Append("<th>RPC</th>");
+	OutHTML.Append("<th>ReliableMulticast</th>");
+	OutHTML.Append("<th>Warning</th>");
+	OutHTML.Append("</tr>\n");
+
+	for(const FBlueprintDocument* SortedBlueprint : SortedBlueprints)
 	{
-		FString FileOutput;
-		//ソート
-		BlueprintDocument.Events.Sort(FGraphSorter());
-		BlueprintDocument.Macros.Sort(FGraphSorter());
-		BlueprintDocument.Functions.Sort(FGraphSorter());
-		BlueprintDocument.Properties.Sort(FPropertySorter());
+		const FBlueprintDocument& BlueprintDocument = *SortedBlueprint;
 
-		//BlueprintTOC
-		if(LastTOCPath != BlueprintDocument.ContentPath)
+		// 条件ごとのプロパティ数
+		TMap<ELifetimeCondition, int32> ConditionCount;
+		int32 PropertyCount = 0;
+		for(const FPropertyDocument& PropertyDocument : BlueprintDocument.Properties)
 		{
-			LastTOCPath = BlueprintDocument.ContentPath;
-			TopicHTML(TOCOutput, 3, BlueprintDocument.ContentPath);
+			if((PropertyDocument.PropertyFlg & CPF_Net) != 0)
+			{
+				ConditionCount.FindOrAdd(PropertyDocument.LifetimeCondition)++;
+				PropertyCount++;
+			}
 		}
-		TOCOutput += FString::Printf(TEXT("<a href=\"%s.html\" target=\"document\">%s</a></br>\n"),*(BlueprintDocument.Name),*(BlueprintDocument.Name));
+		ConditionCount.KeySort(TLess<ELifetimeCondition>());
 
-		// タイトル
-		TopicHTML(FileOutput,1,BlueprintDocument.Name);
-		// 説明
-		FileOutput += FString::Printf(TEXT("%s</br>"), *(BlueprintDocument.ToolTips));
-		// Path
-		TopicHTML(FileOutput, 2, FString(TEXT("ContentPath")));
-		FileOutput += FString::Printf(TEXT("%s</br>"), *(BlueprintDocument.ContentPath));
-		// Parent
-		TopicHTML(FileOutput, 2, FString(TEXT("Parent")));
-		FileOutput += FString::Printf(TEXT("%s</br>"), *(BlueprintDocument.ParentName));
-
-		// Event
-		TopicHTML(FileOutput, 2, FString(TEXT("EventGraph")));
-		EdGraphTableHTML(FileOutput, BlueprintDocument.Events,Document);
+		FBlueprintToDocHTMLWriter ConditionHTML;
+		for(const TPair<ELifetimeCondition, int32>& Condition : ConditionCount)
+		{
+			const ANSICHAR* Label = FBlueprintToDocFlagLabels::GetLifetimeConditionLabel(Condition.Key);
+			ConditionHTML.AppendUTF8(Label, FCStringAnsi::Strlen(Label));
+			ConditionHTML.Append(" x");
+			ConditionHTML.AppendInt(Condition.Value);
+			ConditionHTML.Append("</br>\n");
+		}
 
-		// Macro
-		TopicHTML(FileOutput, 2, FString(TEXT("MacroGraph")));
-		EdGraphTableHTML(FileOutput, BlueprintDocument.Macros,Document);
+		FBlueprintToDocHTMLWriter WarningHTML;
+		AddLine(WarningHTML, BlueprintDocument.AlwaysReplicatedSize >= Settings->AlwaysReplicatedWarningSize, FString(TEXT("Large always-replicated state")));
+		AddLine(WarningHTML, BlueprintDocument.ReliableMulticastCount >= Settings->ReliableMulticastWarningCount, FString(TEXT("Many reliable multicast RPCs")));
+
+		OutHTML.Append("<tr>");
+		AddLinkCell(OutHTML, BlueprintDocument.PageName + TEXT(".html"), BlueprintDocument.Name);
+		AddCell(OutHTML, BlueprintDocument.ContentPath);
+		AddIntCell(OutHTML, PropertyCount);
+		AddCell(OutHTML, SizeToString(BlueprintDocument.ReplicatedSize));
+		AddCell(OutHTML, SizeToString(BlueprintDocument.AlwaysReplicatedSize));
+		AddCell(OutHTML, ConditionHTML);
+		AddIntCell(OutHTML, BlueprintDocument.RPCCount);
+		AddIntCell(OutHTML, BlueprintDocument.ReliableMulticastCount);
+		AddCell(OutHTML, WarningHTML);
+		OutHTML.Append("</tr>\n");
+	}
+	OutHTML.Append("</table>\n");
 
-		// Function
-		TopicHTML(FileOutput, 2, FString(TEXT("Functions")));
-		EdGraphTableHTML(FileOutput, BlueprintDocument.Functions,Document);
+}
 
-		// Property
-		TopicHTML(FileOutput, 2, FString(TEXT("Property")));
-		PropertiesTableHTML(FileOutput, BlueprintDocument.Properties);
+void UBlueprintToDocUtil::MemoryLayoutPageHTML(FBlueprintToDocHTMLWriter& OutHTML, const FDocument& Document)
+{
+	// インスタンスサイズ × 想定インスタンス数の大きい順(インスタンス数は1回だけ求める)
+	struct FLayoutRow
+	{
+		const FBlueprintDocument* Blueprint;
+		int64 InstanceCount;
+		int64 TotalSize;
+	};
+	TArray<FLayoutRow> Rows;
+	Rows.Reserve(Document.Blueprints.Num());
+	for(const FBlueprintDocument& BlueprintDocument : Document.Blueprints)
+	{
+		const int64 InstanceCount = GetExpectedInstanceCount(BlueprintDocument);
+		Rows.Add({ &BlueprintDocument, InstanceCount, BlueprintDocument.InstanceSize * InstanceCount });
+	}
+	Rows.Sort([](const FLayoutRow& A, const FLayoutRow& B)
+	{
+		return A.TotalSize > B.TotalSize;
+	});
+
+	TopicHTML(OutHTML, 1, "MemoryLayout");
+
+	OutHTML.Append("<table>\n");
+	OutHTML.Append("<tr>");
+	OutHTML.Append("<th>Name</th>");
+	OutHTML.Append("<th>Instance</th>");
+	OutHTML.Append("<th>Padding</th>");
+	OutHTML.Append("<th>Optimized</th>");
+	OutHTML.Append("<th>Count</th>");
+	OutHTML.Append("<th>Total</th>");
+	OutHTML.Append("<th>TotalSaving</th>");
+	OutHTML.Append("<th>SuggestedOrder</th>");
+	OutHTML.Append("</tr>\n");
+
+	for(const FLayoutRow& Row : Rows)
+	{
+		const FBlueprintDocument& BlueprintDocument = *Row.Blueprint;
+		const int64 InstanceCount = Row.InstanceCount;
+		const int64 Saving = BlueprintDocument.InstanceSize - BlueprintDocument.OptimizedInstanceSize;
 
-		// HTML出力
-		FString Path = Document.RootPath / "blueprint" / (BlueprintDocument.Name) + ".html";
-		if(!FFileHelper::SaveStringToFile(*FString::Printf(HTMLTemplate, *FileOutput), *Path, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM))
+		// 並べ替えで小さくなる場合のみ提案する
+		FBlueprintToDocHTMLWriter OrderHTML;
+		if(Saving > 0)
 		{
-			UE_LOG(LogBlueprintToDoc, Error, TEXT("Failed Save File:%s"), *Path);
+			for(const FString& PropertyName : BlueprintDocument.SuggestedPropertyOrder)
+			{
+				AddLine(OrderHTML, true, PropertyName);
+			}
 		}
-	}
 
-	// 目次ページ
-	FString Path = Document.RootPath / "blueprint\\toc.html";
-	if(!FFileHelper::SaveStringToFile(*FString::Printf(HTMLTemplate, *TOCOutput), *Path, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM))
-	{
-		UE_LOG(LogBlueprintToDoc,Error,TEXT("Failed Save File:%s"), *Path);
+		OutHTML.Append("<tr>");
+		AddLinkCell(OutHTML, BlueprintDocument.PageName + TEXT(".html"), BlueprintDocument.Name);
+		AddCell(OutHTML, SizeToString(BlueprintDocument.InstanceSize));
+		AddCell(OutHTML, SizeToString(BlueprintDocument.PaddingSize));
+		AddCell(OutHTML, SizeToString(BlueprintDocument.OptimizedInstanceSize));
+		AddIntCell(OutHTML, InstanceCount);
+		AddCell(OutHTML, SizeToString(Row.TotalSize));
+		AddCell(OutHTML, SizeToString(Saving * InstanceCount));
+		AddCell(OutHTML, OrderHTML);
+		OutHTML.Append("</tr>\n");
 	}
+	OutHTML.Append("</table>\n");
 
+}
 
-	// 必要なファイルをコピー
-	IPlatformFile &PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
-	FString LaytoutTemplateDirectory;
+// 見出しをクリックするとその列で並べ替える(数値の列は数値で比べる)
+static const ANSICHAR SortTableScript[] =
+	"<script>\n"
+	"function SortTable(Header){"
+	"var Table=Header.parentNode.parentNode.parentNode;var Column=Header.cellIndex;"
+	"var Rows=Array.prototype.slice.call(Table.rows,1);var Ascending=Header.getAttribute('data-order')!=='asc';"
+	"Header.setAttribute('data-order',Ascending?'asc':'desc');"
+	"Rows.sort(function(A,B){var X=A.cells[Column].textContent,Y=B.cells[Column].textContent;"
+	"var Order=(isNaN(X)||isNaN(Y)||X===''||Y==='')?X.localeCompare(Y):X-Y;return Order*(Ascending?1:-1);});"
+	"Rows.forEach(function(Row){Row.parentNode.appendChild(Row);});}\n"
+	"</script>\n";
+
+void UBlueprintToDocUtil::TodoPageHTML(FBlueprintToDocHTMLWriter& OutHTML, const FDocument& Document)
+{
+	const UBlueprintToDocUserSettings* Settings = GetDefault<UBlueprintToDocUserSettings>();
 
-	// プロジェクトプラグインにプラグインが入っているか確認する
-	LaytoutTemplateDirectory = FPaths::ProjectPluginsDir() / "BlueprintToDoc";
-	if (!PlatformFile.DirectoryExists(*LaytoutTemplateDirectory))
+	struct FTodo
 	{
-		// プロジェクト側になければエンジンプラグインとする
-		LaytoutTemplateDirectory = FPaths::EnginePluginsDir() / "BlueprintToDoc";
-	}
-	// index ページのコピー
+		const FBlueprintDocument* Blueprint;
+		const FEdGraphDocument* EdGraph;
+		const FString* Text;
+		int32 MarkerIndex;
+	};
+
+	// 全グラフを集計(目印の順、ブループリントは目次の順)
+	TArray<FTodo> Todos;
+	TArray<int32> MarkerCounts;
+	MarkerCounts.AddZeroed(Settings->TodoMarkers.Num() + 1);
+	for(const FBlueprintDocument& BlueprintDocument : Document.Blueprints)
 	{
-		Path = Document.RootPath / "index.html";
-		FString LaytoutTemplatePath = LaytoutTemplateDirectory / "HTMLTemplate/index.html";
-		if (!PlatformFile.CopyFile(*Path, *LaytoutTemplatePath))
+		for(const TArray<FEdGraphDocument>* EdGraphs : { &BlueprintDocument.Events, &BlueprintDocument.Macros, &BlueprintDocument.Functions })
 		{
-			UE_LOG(LogBlueprintToDoc, Error, TEXT("Failed Copy File:%s"), *LaytoutTemplatePath);
+			for(const FEdGraphDocument& EdGraph : *EdGraphs)
+			{
+				for(const FString& Todo : EdGraph.TodoList)
+				{
+					// 抽出後に設定が変わった場合は最後に並べる
+					int32 MarkerIndex = Settings->TodoMarkers.IndexOfByPredicate([&Todo](const FString& Marker)
+					{
+						return !Marker.IsEmpty() && Todo.StartsWith(Marker, ESearchCase::CaseSensitive);
+					});
+					MarkerIndex = (MarkerIndex != INDEX_NONE) ? MarkerIndex : Settings->TodoMarkers.Num();
+					MarkerCounts[MarkerIndex]++;
+					Todos.Add({ &BlueprintDocument, &EdGraph, &Todo, MarkerIndex });
+				}
+			}
 		}
 	}
-	// CSSファイルのコピー
+	Todos.StableSort([](const FTodo& A, const FTodo& B)
 	{
-		Path = Document.RootPath / "Layout.css";
-		FString LaytoutTemplatePath = LaytoutTemplateDirectory / "HTMLTemplate/Layout.css";
-		if (!PlatformFile.CopyFile(*Path, *LaytoutTemplatePath))
-		{
-			UE_LOG(LogBlueprintToDoc, Error, TEXT("Failed Copy File:%s"), *LaytoutTemplatePath);
-		}
-	}
-}
+		return A.MarkerIndex < B.MarkerIndex;
+	});
 
-void UBlueprintToDocUtil::TopicHTML(FString& OutString, int32 Level, const FString& Contents)
-{
-	OutString += FString::Printf(TEXT("<h%d>%s</h%d>\n"), Level, *Contents, Level);
-}
+	TopicHTML(OutHTML, 1, "Todo");
 
+	// 目印ごとの数
+	for(int32 MarkerIndex = 0; MarkerIndex < Settings->TodoMarkers.Num(); ++MarkerIndex)
+	{
+		OutHTML.AppendEscaped(Settings->TodoMarkers[MarkerIndex]);
+		OutHTML.Append(" x");
+		OutHTML.AppendInt(MarkerCounts[MarkerIndex]);
+		OutHTML.Append("</br>\n");
+	}
 
-FString UBlueprintToDocUtil::ReplaceHTMLReturenCode(const FString& Source)
-{
-	return Source.Replace(TEXT("\n"), TEXT("</br>\n"));
-}
+	OutHTML.Append(SortTableScript);
+	OutHTML.Append("<table>\n");
+	OutHTML.Append("<tr>");
+	OutHTML.Append("<th onclick=\"SortTable(this)\">Marker</th>");
+	OutHTML.Append("<th onclick=\"SortTable(this)\">Blueprint</th>");
+	OutHTML.Append("<th onclick=\"SortTable(this)\">Graph</th>");
+	OutHTML.Append("<th onclick=\"SortTable(this)\">Text</th>");
+	OutHTML.Append("</tr>\n");
 
-void UBlueprintToDocUtil::AddLine(FString& OutString, bool Result, FString AddString)
-{
-	if(Result)
+	for(const FTodo& Todo : Todos)
 	{
-		OutString += FString::Printf(TEXT("%s</br>\n"), *AddString);
+		OutHTML.Append("<tr>");
+		AddCell(OutHTML, Settings->TodoMarkers.IsValidIndex(Todo.MarkerIndex) ? Settings->TodoMarkers[Todo.MarkerIndex] : FString());
+		AddLinkCell(OutHTML, Todo.Blueprint->PageName + TEXT(".html"), Todo.Blueprint->Name);
+		AddLinkCell(OutHTML, EdGraphHTMLFileName(*Todo.Blueprint, *Todo.EdGraph), Todo.EdGraph->Name);
+		AddCell(OutHTML, *Todo.Text);
+		OutHTML.Append("</tr>\n");
 	}
+	OutHTML.Append("</table>\n");
 }
 
-void UBlueprintToDocUtil::EdGraphTableHTML(FString& OutString, const TArray<FEdGraphDocument>& EdGraphDocuments,FDocument& Document)
+void UBlueprintToDocUtil::AnimBlueprintPageHTML(FBlueprintToDocHTMLWriter& OutHTML, const FDocument& Document)
 {
-	const FString PinTableHeader = FString(TEXT("<table>\n<tr><th>Type</th><th>Name</th><th>TootTip</th></tr>\n"));
-	const FString TableFooter = FString(TEXT("</table>\n"));
-
-	// テーブルのヘッダー部分の追加
-	OutString += FString(TEXT("<table>\n"));
-	OutString += FString(TEXT("<tr>"));
-	OutString += FString(TEXT("<th>Category</th>"));
-	OutString += FString(TEXT("<th>Access</th>"));
-	OutString += FString(TEXT("<th>Name</th>"));
-	OutString += FString(TEXT("<th>TootTip</th>"));
-	OutString += FString(TEXT("<th>Input</th>"));
-	OutString += FString(TEXT("<th>Output</th>"));
-	OutString += FString(TEXT("<th>Net</th>"));
-	OutString += FString(TEXT("<th>Flag</th>"));
-	OutString += FString(TEXT("</tr>\n"));
-
-	for(FEdGraphDocument EdGraph : EdGraphDocuments)
-	{
-		FString HTMLFileName = FString::Printf(TEXT("%s_%s.html"), *(EdGraph.Parent), *(EdGraph.Name.Replace(TEXT(" "), TEXT(""))));
-		FString Path = Document.RootPath / "blueprint" / HTMLFileName;
-
-		FString FunctionHTMLString;
-		FString FunctionInputString;
-		FString FunctionOutputString;
-		FString AccessString;
-		FString NetString;
-		FString FlagString;
-
-
-		TopicHTML(FunctionHTMLString, 1, EdGraph.Name);
-		FunctionHTMLString += FString::Printf(TEXT("%s</br>"), *(ReplaceHTMLReturenCode(EdGraph.ToolTips)));
-		TopicHTML(FunctionHTMLString, 2, TEXT("Category"));
-		FunctionHTMLString += FString::Printf(TEXT("%s</br>"), *(EdGraph.Category));
-
-		if(EdGraph.TodoList.Num() > 0)
+	struct FAnimBlueprintCost
+	{
+		const FBlueprintDocument* Blueprint;
+		int32 SlowPathNodeCount;
+		int32 ThreadUnsafeNodeCount;
+		int32 MaxStateNodeCount;
+	};
+
+	// アニメーションブループリントを集計
+	TArray<FAnimBlueprintCost> Costs;
+	for(const FBlueprintDocument& BlueprintDocument : Document.Blueprints)
+	{
+		if(!BlueprintDocument.bIsAnimBlueprint)
 		{
-			TopicHTML(FunctionHTMLString, 2, TEXT("Todo"));
-			for(FString Todo : EdGraph.TodoList)
-			{
-				FunctionHTMLString += FString::Printf(TEXT("%s</br>"), *(Todo));
-			}
+			continue;
 		}
 
-		// アクセス
-		AddLine(AccessString, ((EdGraph.Flag & FUNC_Public) != 0),                 FString(TEXT("Public")));
-		AddLine(AccessString, ((EdGraph.Flag & FUNC_Private) != 0),                FString(TEXT("Private")));
-		AddLine(AccessString, ((EdGraph.Flag & FUNC_Protected) != 0),              FString(TEXT("Protected")));
-		// ネット
-		AddLine(NetString,    ((EdGraph.Flag & FUNC_NetResponse) != 0),            FString(TEXT("NetResponse")));
-		AddLine(NetString,    ((EdGraph.Flag & FUNC_NetServer) != 0),              FString(TEXT("NetServer")));
-		AddLine(NetString,    ((EdGraph.Flag & FUNC_NetMulticast) != 0),           FString(TEXT("NetMulticast")));
-		AddLine(NetString,    ((EdGraph.Flag & FUNC_NetRequest) != 0),             FString(TEXT("NetRequest")));
-		AddLine(NetString,    ((EdGraph.Flag & FUNC_NetClient) != 0),              FString(TEXT("NetClient")));
-		AddLine(NetString,    ((EdGraph.Flag & FUNC_NetReliable) != 0),            FString(TEXT("NetReliable")));
-		// FunctionFlag
-		AddLine(FlagString,   ((EdGraph.Flag & FUNC_Final) != 0),                  FString(TEXT("Final")));
-		AddLine(FlagString,   ((EdGraph.Flag & FUNC_RequiredAPI) != 0),            FString(TEXT("RequiredAPI")));
-		AddLine(FlagString,   ((EdGraph.Flag & FUNC_BlueprintAuthorityOnly) != 0), FString(TEXT("BlueprintAuthorityOnly")));
-		AddLine(FlagString,   ((EdGraph.Flag & FUNC_RequiredAPI) != 0),            FString(TEXT("RequiredAPI")));
-		AddLine(FlagString,   ((EdGraph.Flag & FUNC_BlueprintCosmetic) != 0),      FString(TEXT("BlueprintCosmetic")));
-		AddLine(FlagString,   ((EdGraph.Flag & FUNC_Exec) != 0),                   FString(TEXT("Exec")));
-		AddLine(FlagString,   ((EdGraph.Flag & FUNC_Native) != 0),                 FString(TEXT("Native")));
-		AddLine(FlagString,   ((EdGraph.Flag & FUNC_Event) != 0),                  FString(TEXT("Event")));
-		AddLine(FlagString,   ((EdGraph.Flag & FUNC_Static) != 0),                 FString(TEXT("Static")));
-		AddLine(FlagString,   ((EdGraph.Flag & FUNC_MulticastDelegate) != 0),      FString(TEXT("MulticastDelegate")));
-		AddLine(FlagString,   ((EdGraph.Flag & FUNC_BlueprintCallable) != 0),      FString(TEXT("BlueprintCallable")));
-		AddLine(FlagString,   ((EdGraph.Flag & FUNC_BlueprintEvent) != 0),         FString(TEXT("BlueprintEvent")));
-		AddLine(FlagString,   ((EdGraph.Flag & FUNC_BlueprintPure) != 0),          FString(TEXT("BlueprintPure")));
-		AddLine(FlagString,   ((EdGraph.Flag & FUNC_EditorOnly) != 0),             FString(TEXT("EditorOnly")));
-		AddLine(FlagString,   ((EdGraph.Flag & FUNC_Const) != 0),                  FString(TEXT("Const")));
-		AddLine(FlagString,   ((EdGraph.Flag & FUNC_NetValidate) != 0),            FString(TEXT("NetValidate")));
-		AddLine(FlagString,   ((EdGraph.Flag & FUNC_Delegate) != 0),               FString(TEXT("Delegate")));
-		AddLine(FlagString,   ((EdGraph.Flag & FUNC_HasOutParms) != 0),            FString(TEXT("HasOutParms")));
-		AddLine(FlagString,   ((EdGraph.Flag & FUNC_HasDefaults) != 0),            FString(TEXT("HasDefaults")));
-		AddLine(FlagString,   ((EdGraph.Flag & FUNC_DLLImport) != 0),              FString(TEXT("DLLImport")));
-
-
-		if(!AccessString.IsEmpty())
+		FAnimBlueprintCost Cost = { &BlueprintDocument, 0, 0, 0 };
+		for(const FAnimNodeDocument& AnimNodeDocument : BlueprintDocument.AnimNodes)
 		{
-			TopicHTML(FunctionHTMLString, 2, TEXT("Access"));
-			FunctionHTMLString += AccessString;
+			Cost.SlowPathNodeCount += (AnimNodeDocument.SlowPathPinCount > 0) ? 1 : 0;
+			Cost.ThreadUnsafeNodeCount += (AnimNodeDocument.ThreadUnsafeCalls.Num() > 0) ? 1 : 0;
 		}
-		if(!NetString.IsEmpty())
+		for(const FAnimStateDocument& AnimStateDocument : BlueprintDocument.AnimStates)
 		{
-			TopicHTML(FunctionHTMLString, 2, TEXT("Net"));
-			FunctionHTMLString += NetString;
+			Cost.MaxStateNodeCount = FMath::Max(Cost.MaxStateNodeCount, AnimStateDocument.NodeCount);
 		}
-		if(!FlagString.IsEmpty())
+		Costs.Add(Cost);
+	}
+
+	// 高速パスで読めないノードが多い順
+	Costs.Sort([](const FAnimBlueprintCost& A, const FAnimBlueprintCost& B)
+	{
+		if(A.SlowPathNodeCount != B.SlowPathNodeCount)
 		{
-			TopicHTML(FunctionHTMLString, 2, TEXT("FunctionFlag"));
-			FunctionHTMLString += FlagString;
+			return A.SlowPathNodeCount > B.SlowPathNodeCount;
 		}
-
-		// インプットピン
-		TopicHTML(FunctionHTMLString, 2, TEXT("Input"));
-		FunctionHTMLString += PinTableHeader;
-		TArray<FString> PinKeys;
-		EdGraph.Input.GetKeys(PinKeys);
-		for(FString PinKey : PinKeys)
+		if(A.ThreadUnsafeNodeCount != B.ThreadUnsafeNodeCount)
 		{
-			const FEdGraphPinDocument* PinDocument = EdGraph.Input.Find(PinKey);
-			if(PinDocument == nullptr)
-			{
-				continue;
-			}
-
-			// 関数ドキュメント用
-			FunctionHTMLString += FString(TEXT("<tr>"));
-			FunctionHTMLString += FString::Printf(TEXT("<td>%s</td>"), *(PinDocument->Type));
-			FunctionHTMLString += FString::Printf(TEXT("<td>%s</td>"), *(PinDocument->Name));
-			FunctionHTMLString += FString::Printf(TEXT("<td>%s</td>"), *(PinDocument->ToolTips));
-			FunctionHTMLString += FString(TEXT("</tr>"));
+			return A.ThreadUnsafeNodeCount > B.ThreadUnsafeNodeCount;
+		}
+		return A.Blueprint->AnimNodes.Num() > B.Blueprint->AnimNodes.Num();
+	});
+
+	TopicHTML(OutHTML, 1, "AnimBlueprints");
+
+	OutHTML.Append("<table>\n");
+	OutHTML.Append("<tr>");
+	OutHTML.Append("<th>Rank</th>");
+	OutHTML.Append("<th>Name</th>");
+	OutHTML.Append("<th>ContentPath</th>");
+	OutHTML.Append("<th>Nodes</th>");
+	OutHTML.Append("<th>SlowPathNodes</th>");
+	OutHTML.Append("<th>ThreadUnsafeNodes</th>");
+	OutHTML.Append("<th>States</th>");
+	OutHTML.Append("<th>MaxStateNodes</th>");
+	OutHTML.Append("<th>Warning</th>");
+	OutHTML.Append("</tr>\n");
+
+	int32 Rank = 1;
+	for(const FAnimBlueprintCost& Cost : Costs)
+	{
+		const FBlueprintDocument& BlueprintDocument = *Cost.Blueprint;
+
+		FBlueprintToDocHTMLWriter WarningHTML;
+		AddLine(WarningHTML, !BlueprintDocument.bUseMultiThreadedAnimationUpdate, FString(TEXT("Updated on game thread")));
+		AddLine(WarningHTML, BlueprintDocument.bUseMultiThreadedAnimationUpdate && Cost.ThreadUnsafeNodeCount > 0, FString(TEXT("Thread-unsafe calls in worker update")));
+
+		OutHTML.Append("<tr>");
+		AddIntCell(OutHTML, Rank++);
+		AddLinkCell(OutHTML, BlueprintDocument.PageName + TEXT(".html"), BlueprintDocument.Name);
+		AddCell(OutHTML, BlueprintDocument.ContentPath);
+		AddIntCell(OutHTML, BlueprintDocument.AnimNodes.Num());
+		AddIntCell(OutHTML, Cost.SlowPathNodeCount);
+		AddIntCell(OutHTML, Cost.ThreadUnsafeNodeCount);
+		AddIntCell(OutHTML, BlueprintDocument.AnimStates.Num());
+		AddIntCell(OutHTML, Cost.MaxStateNodeCount);
+		AddCell(OutHTML, WarningHTML);
+		OutHTML.Append("</tr>\n");
+	}
+	OutHTML.Append("</table>\n");
+}
 
-			// ブループリントドキュメント用
-			FunctionInputString += FString::Printf(TEXT("<b>%s</b>　<i>%s</i></br>"), *(PinDocument->Type), *(PinDocument->Name));
-			FunctionInputString += FString::Printf(TEXT("%s</br>"), *(PinDocument->ToolTips));
+void UBlueprintToDocUtil::WidgetBlueprintPageHTML(FBlueprintToDocHTMLWriter& OutHTML, const FDocument& Document)
+{
+	struct FWidgetBlueprintCost
+	{
+		const FBlueprintDocument* Blueprint;
+		// 毎フレーム評価されるバインドとTick
+		int32 PerFrameCount;
+		// バインドした関数のノード数の合計
+		int32 BindingNodeCount;
+	};
+
+	// ウィジェットブループリントを集計
+	TArray<FWidgetBlueprintCost> Costs;
+	for(const FBlueprintDocument& BlueprintDocument : Document.Blueprints)
+	{
+		if(!BlueprintDocument.bIsWidgetBlueprint)
+		{
+			continue;
 		}
-		FunctionHTMLString += TableFooter;
 
-		// アウトプットピン
-		TopicHTML(FunctionHTMLString, 2, TEXT("Output"));
-		FunctionHTMLString += PinTableHeader;
-		EdGraph.Output.GetKeys(PinKeys);
-		for(FString PinKey : PinKeys)
+		FWidgetBlueprintCost Cost = { &BlueprintDocument, BlueprintDocument.WidgetBindings.Num() + BlueprintDocument.WidgetTickOverrides.Num(), 0 };
+		for(const FWidgetBindingDocument& BindingDocument : BlueprintDocument.WidgetBindings)
 		{
-			const FEdGraphPinDocument* PinDocument = EdGraph.Output.Find(PinKey);
-			if(PinDocument == nullptr)
+			for(const FEdGraphDocument& EdGraph : BlueprintDocument.Functions)
 			{
-				continue;
+				if(!BindingDocument.FunctionName.IsNone() && EdGraph.GraphName == BindingDocument.FunctionName)
+				{
+					Cost.BindingNodeCount += EdGraph.NodeCount;
+				}
 			}
-
-			// 関数ドキュメント用
-			FunctionHTMLString += FString(TEXT("<tr>"));
-			FunctionHTMLString += FString::Printf(TEXT("<td>%s</td>"), *(PinDocument->Type));
-			FunctionHTMLString += FString::Printf(TEXT("<td>%s</td>"), *(PinDocument->Name));
-			FunctionHTMLString += FString::Printf(TEXT("<td>%s</td>"), *(PinDocument->ToolTips));
-			FunctionHTMLString += FString(TEXT("</tr>"));
-
-			// ブループリントドキュメント用
-			FunctionOutputString += FString::Printf(TEXT("<b>%s</b>　<i>%s</i></br>"), *(PinDocument->Type), *(PinDocument->Name));
-			FunctionOutputString += FString::Printf(TEXT("%s</br>"), *(PinDocument->ToolTips));
 		}
-		FunctionHTMLString += TableFooter;
-
+		Costs.Add(Cost);
+	}
 
-		// 関数ドキュメント ファイル出力
-		FString OutHTML = FString::Printf(HTMLTemplate, *FunctionHTMLString);
-		if(!FFileHelper::SaveStringToFile(*OutHTML, *Path, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM))
+	// 毎フレーム評価されるものが多い順
+	Costs.Sort([](const FWidgetBlueprintCost& A, const FWidgetBlueprintCost& B)
+	{
+		if(A.PerFrameCount != B.PerFrameCount)
 		{
-			UE_LOG(LogBlueprintToDoc,Error,TEXT("Failed Save File:%s"),*Path);
+			return A.PerFrameCount > B.PerFrameCount;
 		}
-
-		OutString += FString::Printf(TEXT("<tr>"));
-		OutString += FString::Printf(TEXT("<td>%s</td>"), *(EdGraph.Category));
-		OutString += FString::Printf(TEXT("<td>%s</td>"), *(AccessString));
-		OutString += FString::Printf(TEXT("<td><a href=\"%s\" target=\"document\">%s</a></td>\n"), *(HTMLFileName), *(EdGraph.Name));
-		OutString += FString::Printf(TEXT("<td>%s</td>"), *(ReplaceHTMLReturenCode(EdGraph.ToolTips)));
-		OutString += FString::Printf(TEXT("<td>%s</td>"), *FunctionInputString);
-		OutString += FString::Printf(TEXT("<td>%s</td>"), *FunctionOutputString);
-		OutString += FString::Printf(TEXT("<td>%s</td>"), *(NetString));
-		OutString += FString::Printf(TEXT("<td>%s</td>"), *(FlagString));
-		OutString += FString::Printf(TEXT("</tr>\n"));
+		if(A.BindingNodeCount != B.BindingNodeCount)
+		{
+			return A.BindingNodeCount > B.BindingNodeCount;
+		}
+		return A.Blueprint->WidgetCount > B.Blueprint->WidgetCount;
+	});
+
+	TopicHTML(OutHTML, 1, "WidgetBlueprints");
+
+	OutHTML.Append(SortTableScript);
+	OutHTML.Append("<table>\n");
+	OutHTML.Append("<tr>");
+	OutHTML.Append("<th onclick=\"SortTable(this)\">Rank</th>");
+	OutHTML.Append("<th onclick=\"SortTable(this)\">Name</th>");
+	OutHTML.Append("<th onclick=\"SortTable(this)\">ContentPath</th>");
+	OutHTML.Append("<th onclick=\"SortTable(this)\">Bindings</th>");
+	OutHTML.Append("<th onclick=\"SortTable(this)\">BindingNodes</th>");
+	OutHTML.Append("<th onclick=\"SortTable(this)\">TickOverrides</th>");
+	OutHTML.Append("<th onclick=\"SortTable(this)\">Widgets</th>");
+	OutHTML.Append("<th onclick=\"SortTable(this)\">Depth</th>");
+	OutHTML.Append("<th onclick=\"SortTable(this)\">Volatile</th>");
+	OutHTML.Append("<th onclick=\"SortTable(this)\">InvalidationBox</th>");
+	OutHTML.Append("<th onclick=\"SortTable(this)\">RetainerBox</th>");
+	OutHTML.Append("</tr>\n");
+
+	int32 Rank = 1;
+	for(const FWidgetBlueprintCost& Cost : Costs)
+	{
+		const FBlueprintDocument& BlueprintDocument = *Cost.Blueprint;
+
+		OutHTML.Append("<tr>");
+		AddIntCell(OutHTML, Rank++);
+		AddLinkCell(OutHTML, BlueprintDocument.PageName + TEXT(".html"), BlueprintDocument.Name);
+		AddCell(OutHTML, BlueprintDocument.ContentPath);
+		AddIntCell(OutHTML, BlueprintDocument.WidgetBindings.Num());
+		AddIntCell(OutHTML, Cost.BindingNodeCount);
+		AddIntCell(OutHTML, BlueprintDocument.WidgetTickOverrides.Num());
+		AddIntCell(OutHTML, BlueprintDocument.WidgetCount);
+		AddIntCell(OutHTML, BlueprintDocument.WidgetTreeDepth);
+		AddIntCell(OutHTML, BlueprintDocument.VolatileWidgetCount);
+		AddIntCell(OutHTML, BlueprintDocument.InvalidationBoxCount);
+		AddIntCell(OutHTML, BlueprintDocument.RetainerBoxCount);
+		OutHTML.Append("</tr>\n");
 	}
-	OutString += FString::Printf(TEXT("</table>\n"));
+	OutHTML.Append("</table>\n");
 }
 
-
-
-void UBlueprintToDocUtil::PropertiesTableHTML(FString& OutString, const TArray<FPropertyDocument>& PropertiesDocuments)
+void UBlueprintToDocUtil::MacroExpansionPageHTML(FBlueprintToDocHTMLWriter& OutHTML, const FDocument& Document)
 {
-	OutString += FString(TEXT("<table>\n"));
-	OutString += FString(TEXT("<tr>"));
-	OutString += FString(TEXT("<th>Category</th>"));
-	OutString += FString(TEXT("<th>Access</th>"));
-	OutString += FString(TEXT("<th>Type</th>"));
-	OutString += FString(TEXT("<th>Name</th>"));
-	OutString += FString(TEXT("<th>TootTip</th>"));
-	OutString += FString(TEXT("<th>Net</th>"));
-	OutString += FString(TEXT("<th>Flag</th>"));
-	OutString += FString(TEXT("</tr>\n"));
-
-	for(FPropertyDocument PropertyDocument : PropertiesDocuments)
+	struct FMacroTotal
 	{
-		FString AccessString;
-		FString NetString;
-		FString FlagString;
-
-		// 各プロパティフラグの情報を文字列化
-		AddLine(FlagString,  ((PropertyDocument.PropertyFlg&CPF_Edit)!=0),                  FString(TEXT("Edit")));
-		AddLine(FlagString,  ((PropertyDocument.PropertyFlg&CPF_ConstParm)!=0),             FString(TEXT("ConstParm")));
-		AddLine(FlagString,  ((PropertyDocument.PropertyFlg&CPF_BlueprintVisible)!=0),      FString(TEXT("BlueprintVisible")));
-		AddLine(FlagString,  ((PropertyDocument.PropertyFlg&CPF_ExportObject)!=0),          FString(TEXT("ExportObject")));
-		AddLine(FlagString,  ((PropertyDocument.PropertyFlg&CPF_Parm)!=0),                  FString(TEXT("Parm")));
-		AddLine(FlagString,  ((PropertyDocument.PropertyFlg&CPF_ZeroConstructor)!=0),       FString(TEXT("ZeroConstructor")));
-		AddLine(FlagString,  ((PropertyDocument.PropertyFlg&CPF_DisableEditOnTemplate)!=0), FString(TEXT("DisableEditOnTemplate")));
-		AddLine(FlagString,  ((PropertyDocument.PropertyFlg&CPF_Transient)!=0),             FString(TEXT("Transient")));
-		AddLine(FlagString,  ((PropertyDocument.PropertyFlg&CPF_Config)!=0),                FString(TEXT("Config")));
-		AddLine(FlagString,  ((PropertyDocument.PropertyFlg&CPF_DisableEditOnInstance)!=0), FString(TEXT("DisableEditOnInstance")));
-		AddLine(FlagString,  ((PropertyDocument.PropertyFlg&CPF_EditConst)!=0),             FString(TEXT("EditConst")));
-		AddLine(FlagString,  ((PropertyDocument.PropertyFlg&CPF_GlobalConfig)!=0),          FString(TEXT("GlobalConfig")));
-		AddLine(FlagString,  ((PropertyDocument.PropertyFlg&CPF_InstancedReference)!=0),    FString(TEXT("InstancedReference")));
-		AddLine(FlagString,  ((PropertyDocument.PropertyFlg&CPF_DuplicateTransient)!=0),    FString(TEXT("DuplicateTransient")));
-		AddLine(FlagString,  ((PropertyDocument.PropertyFlg&CPF_SubobjectReference)!=0),    FString(TEXT("SubobjectReference")));
-		AddLine(FlagString,  ((PropertyDocument.PropertyFlg&CPF_SaveGame)!=0),              FString(TEXT("SaveGame")));
-		AddLine(FlagString,  ((PropertyDocument.PropertyFlg&CPF_ReferenceParm)!=0),         FString(TEXT("ReferenceParm")));
-		AddLine(FlagString,  ((PropertyDocument.PropertyFlg&CPF_Deprecated)!=0),            FString(TEXT("Deprecated")));
-		AddLine(FlagString,  ((PropertyDocument.PropertyFlg&CPF_IsPlainOldData)!=0),        FString(TEXT("IsPlainOldData")));
-		AddLine(NetString,   ((PropertyDocument.PropertyFlg&CPF_Net)!=0),                   FString(TEXT("Net")));
-		AddLine(NetString,   ((PropertyDocument.PropertyFlg&CPF_RepSkip)!=0),               FString(TEXT("RepSkip")));
-		AddLine(NetString,   ((PropertyDocument.PropertyFlg&CPF_RepNotify)!=0),             FString(TEXT("RepNotify")));
-		AddLine(AccessString,((PropertyDocument.PropertyFlg&CPF_Protected)!=0),             FString(TEXT("Protected")));
-		AddLine(FlagString,  ((PropertyDocument.PropertyFlg&CPF_ExposeOnSpawn)!=0),         FString(TEXT("ExposeOnSpawn")));
-		AddLine(FlagString,  ((PropertyDocument.PropertyFlg&CPF_EditorOnly)!=0),            FString(TEXT("EditorOnly")));
-		AddLine(FlagString,  ((PropertyDocument.PropertyFlg&CPF_Interp)!=0),                FString(TEXT("Interp")));
-		AddLine(FlagString,  ((PropertyDocument.PropertyFlg&CPF_NonTransactional)!=0),      FString(TEXT("NonTransactional")));
-		AddLine(FlagString,  ((PropertyDocument.PropertyFlg&CPF_BlueprintCallable)!=0),     FString(TEXT("BlueprintCallable")));
-		AddLine(FlagString,  ((PropertyDocument.PropertyFlg&CPF_BlueprintAuthorityOnly)!=0),FString(TEXT("BlueprintAuthorityOnly")));
-
-		// Lifetime
-		AddLine(NetString, true, *LifetimeConditionToString(PropertyDocument.LifetimeCondition));
-
-		OutString += FString::Printf(TEXT("<tr>"));
-		OutString += FString::Printf(TEXT("<td>%s</td>"), *(PropertyDocument.Category));
-		OutString += FString::Printf(TEXT("<td>%s</td>"), *(AccessString));
-		OutString += FString::Printf(TEXT("<td>%s</td>"), *(PropertyDocument.Type));
-		OutString += FString::Printf(TEXT("<td>%s</td>"), *(PropertyDocument.Name));
-		OutString += FString::Printf(TEXT("<td>%s</td>"), *(ReplaceHTMLReturenCode(PropertyDocument.ToolTips)));
-		OutString += FString::Printf(TEXT("<td>%s</td>"), *(NetString));
-		OutString += FString::Printf(TEXT("<td>%s</td>"), *(FlagString));
-		OutString += FString::Printf(TEXT("</tr>\n"));
-	}
-	OutString += FString::Printf(TEXT("</table>\n"));
-}
-
-void UBlueprintToDocUtil::CategoryPageHTML(FDocument& Document, FName Category)
-{
-	FString HTMLOutput;
-	FString LastTOCPath;
-	Document.Blueprints.Sort(FBlueprintSorter());
-
-
-	// ブループリント
-	for (FBlueprintDocument BlueprintDocument : Document.Blueprints)
+		const FMacroUsageDocument* MacroUsage = nullptr;
+		int32 InstanceCount = 0;
+		int32 BlueprintCount = 0;
+	};
+	struct FBlueprintTotal
+	{
+		const FBlueprintDocument* Blueprint;
+		int32 InstanceCount;
+		int32 ExpandedNodeCount;
+	};
+
+	// マクロごととブループリントごとに集計
+	TMap<FName, FMacroTotal> MacroTotals;
+	TArray<FBlueprintTotal> BlueprintTotals;
+	for(const FBlueprintDocument& BlueprintDocument : Document.Blueprints)
 	{
-		FString OutString;
-		//ソート
-		BlueprintDocument.Properties.Sort(FPropertySorter());
+		if(BlueprintDocument.MacroUsages.Num() == 0)
+		{
+			continue;
+		}
 
-		for (FPropertyDocument PropertyDocument : BlueprintDocument.Properties)
+		FBlueprintTotal& BlueprintTotal = BlueprintTotals.Add_GetRef({ &BlueprintDocument, 0, 0 });
+		for(const FMacroUsageDocument& MacroUsage : BlueprintDocument.MacroUsages)
 		{
-			if (PropertyDocument.Category.Find(Category.ToString()) != INDEX_NONE)
+			BlueprintTotal.InstanceCount += MacroUsage.InstanceCount;
+			BlueprintTotal.ExpandedNodeCount += MacroUsage.InstanceCount * MacroUsage.ExpandedNodeCount;
+
+			FMacroTotal& MacroTotal = MacroTotals.FindOrAdd(MacroUsage.MacroPath);
+			if(MacroTotal.MacroUsage == nullptr)
 			{
-				OutString += FString::Printf(TEXT("<tr>"));
-				OutString += FString::Printf(TEXT("<td>%s</td>"), *(PropertyDocument.Name));
-				OutString += FString::Printf(TEXT("<td>%s</td>"), *(PropertyDocument.Type));
-				OutString += FString::Printf(TEXT("<td>%s</td>"), *(PropertyDocument.Category));
-				OutString += FString::Printf(TEXT("<td>%s</td>"), *(ReplaceHTMLReturenCode(PropertyDocument.ToolTips)));
-				OutString += FString::Printf(TEXT("</tr>\n"));
+				MacroTotal = { &MacroUsage, 0, 0 };
 			}
+			MacroTotal.InstanceCount += MacroUsage.InstanceCount;
+			MacroTotal.BlueprintCount++;
 		}
-		if (!OutString.IsEmpty())
-		{
-			TopicHTML(HTMLOutput, 2, FString::Printf(TEXT("<a href=\"%s.html\" target=\"document\">%s</a></br>\n"), *(BlueprintDocument.Name), *(BlueprintDocument.Name)));
+	}
 
-			HTMLOutput += FString(TEXT("<table>\n"));
-			HTMLOutput += FString(TEXT("<tr>"));
-			HTMLOutput += FString(TEXT("<th>Name</th>"));
-			HTMLOutput += FString(TEXT("<th>Type</th>"));
-			HTMLOutput += FString(TEXT("<th>Category</th>"));
-			HTMLOutput += FString(TEXT("<th>TootTip</th>"));
-			HTMLOutput += FString(TEXT("</tr>\n"));
-			HTMLOutput += OutString;
-			HTMLOutput += FString(TEXT("</table>"));
-		}
+	// 展開したノード数の合計が多い順
+	TArray<FMacroTotal> SortedMacroTotals;
+	MacroTotals.GenerateValueArray(SortedMacroTotals);
+	SortedMacroTotals.Sort([](const FMacroTotal& A, const FMacroTotal& B)
+	{
+		return A.InstanceCount * A.MacroUsage->ExpandedNodeCount > B.InstanceCount * B.MacroUsage->ExpandedNodeCount;
+	});
+	BlueprintTotals.Sort([](const FBlueprintTotal& A, const FBlueprintTotal& B)
+	{
+		return A.ExpandedNodeCount > B.ExpandedNodeCount;
+	});
+
+	const FDocumentSymbolTable& Symbols = Document.GetSymbols();
+
+	TopicHTML(OutHTML, 1, "Macros");
+
+	OutHTML.Append("<table>\n");
+	OutHTML.Append("<tr>");
+	OutHTML.Append("<th>Rank</th>");
+	OutHTML.Append("<th>Macro</th>");
+	OutHTML.Append("<th>Library</th>");
+	OutHTML.Append("<th>ExpandedNodes</th>");
+	OutHTML.Append("<th>Instances</th>");
+	OutHTML.Append("<th>Blueprints</th>");
+	OutHTML.Append("<th>TotalNodes</th>");
+	OutHTML.Append("</tr>\n");
+
+	int32 Rank = 1;
+	for(const FMacroTotal& MacroTotal : SortedMacroTotals)
+	{
+		OutHTML.Append("<tr>");
+		AddIntCell(OutHTML, Rank++);
+		AddCell(OutHTML, MacroTotal.MacroUsage->Name);
+		AddTypeCell(OutHTML, MacroTotal.MacroUsage->Library, MacroTotal.MacroUsage->LibraryPath, Symbols);
+		AddIntCell(OutHTML, MacroTotal.MacroUsage->ExpandedNodeCount);
+		AddIntCell(OutHTML, MacroTotal.InstanceCount);
+		AddIntCell(OutHTML, MacroTotal.BlueprintCount);
+		AddIntCell(OutHTML, MacroTotal.InstanceCount * MacroTotal.MacroUsage->ExpandedNodeCount);
+		OutHTML.Append("</tr>\n");
 	}
+	OutHTML.Append("</table>\n");
 
+	TopicHTML(OutHTML, 2, "Blueprints");
 
-	FString Path = Document.RootPath / "blueprint" / (Category.ToString()+".html");
+	OutHTML.Append("<table>\n");
+	OutHTML.Append("<tr>");
+	OutHTML.Append("<th>Rank</th>");
+	OutHTML.Append("<th>Name</th>");
+	OutHTML.Append("<th>ContentPath</th>");
+	OutHTML.Append("<th>Instances</th>");
+	OutHTML.Append("<th>ExpandedNodes</th>");
+	OutHTML.Append("</tr>\n");
 
-	if (!FFileHelper::SaveStringToFile(*FString::Printf(HTMLTemplate, *HTMLOutput), *Path, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM))
+	Rank = 1;
+	for(const FBlueprintTotal& BlueprintTotal : BlueprintTotals)
 	{
-		UE_LOG(LogBlueprintToDoc, Error, TEXT("Failed Save File:%s"), *Path);
+		OutHTML.Append("<tr>");
+		AddIntCell(OutHTML, Rank++);
+		AddLinkCell(OutHTML, BlueprintTotal.Blueprint->PageName + TEXT(".html"), BlueprintTotal.Blueprint->Name);
+		AddCell(OutHTML, BlueprintTotal.Blueprint->ContentPath);
+		AddIntCell(OutHTML, BlueprintTotal.InstanceCount);
+		AddIntCell(OutHTML, BlueprintTotal.ExpandedNodeCount);
+		OutHTML.Append("</tr>\n");
 	}
+	OutHTML.Append("</table>\n");
+}
+
+int32 UBlueprintToDocUtil::GetExpectedInstanceCount(const FBlueprintDocument& BlueprintDocument)
+{
+	const UBlueprintToDocUserSettings* Settings = GetDefault<UBlueprintToDocUserSettings>();
 
+	const int32* InstanceCount = Settings->ExpectedInstanceCounts.Find(FName(*BlueprintDocument.Name));
+	return (InstanceCount != nullptr) ? *InstanceCount : Settings->DefaultExpectedInstanceCount;
 }
 
-FString UBlueprintToDocUtil::LifetimeConditionToString(ELifetimeCondition Condition)
+FString UBlueprintToDocUtil::SizeToString(int64 Size)
 {
-	// Lifetime
-	switch (Condition)
+	if(Size >= 1024 * 1024)
+	{
+		return FString::Printf(TEXT("%.2f MB"), Size / (1024.0 * 1024.0));
+	}
+	if(Size >= 1024)
 	{
-	case COND_None:							return FString(TEXT("None"));					
-	case COND_InitialOnly:					return FString(TEXT("Initial Only"));					// This property will only attempt to send on the initial bunch
-	case COND_OwnerOnly:					return FString(TEXT("Owner Only"));						// This property will only send to the actor's owner
-	case COND_SkipOwner:					return FString(TEXT("Skip Owner"));						// This property send to every connection EXCEPT the owner
-	case COND_SimulatedOnly:				return FString(TEXT("Simulated Only"));					// This property will only send to simulated actors
-	case COND_AutonomousOnly:				return FString(TEXT("Autonomous Only"));					// This property will only send to autonomous actors
-	case COND_SimulatedOrPhysics:			return FString(TEXT("Simulated Or Physics"));			// This property will send to simulated OR bRepPhysics actors
-	case COND_InitialOrOwner:				return FString(TEXT("Initial Or Owner"));				// This property will send on the initial packet, or to the actors owner
-	case COND_Custom:						return FString(TEXT("Custom"));							// This property has no particular condition, but wants the ability to toggle on/off via SetCustomIsActiveOverride
-	case COND_ReplayOrOwner:				return FString(TEXT("Replay Or Owner"));					// This property will only send to the replay connection, or to the actors owner
-	case COND_ReplayOnly:					return FString(TEXT("Replay Only"));						// This property will only send to the replay connection
-	case COND_SimulatedOnlyNoReplay:		return FString(TEXT("Simulated Only No Replay"));		// This property will send to actors only, but not to replay connections
-	case COND_SimulatedOrPhysicsNoReplay:	return FString(TEXT("Simulated Or Physics No Replay"));	// This property will send to simulated Or bRepPhysics actors, but not to replay connections
-	case COND_SkipReplay:					return FString(TEXT("Skip Replay"));						// This property will not send to the replay connection
-	case COND_Max:
-		break;
-	default:
-		break;
+		return FString::Printf(TEXT("%.2f KB"), Size / 1024.0);
 	}
-	return FString(TEXT(""));
+	return FString::Printf(TEXT("%lld B"), Size);
 }
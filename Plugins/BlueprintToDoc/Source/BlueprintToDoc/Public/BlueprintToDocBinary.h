@@ -0,0 +1,169 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/ArrayView.h"
+
+class IMappedFileHandle;
+class IMappedFileRegion;
+
+/**
+ * ドキュメント情報のバイナリ形式
+ * 全てのレコードは固定長で、ポインタの代わりにインデックスを持つ
+ * 文字列は重複を除いた文字列テーブルへのインデックス(UTF-8、終端文字あり)
+ */
+namespace BlueprintToDocBinary
+{
+	static const uint32 Magic = 0x42445042; // "BPDB"
+	static const uint32 Version = 1;
+
+	// グラフの種類
+	enum class EGraphKind : uint32
+	{
+		Event,
+		Macro,
+		Function,
+	};
+}
+
+// ヘッダ
+struct FBlueprintToDocBinaryHeader
+{
+	uint32 Magic;
+	uint32 Version;
+	uint32 BlueprintCount;
+	uint32 GraphCount;
+	uint32 PinCount;
+	uint32 PropertyCount;
+	uint32 StringCount;
+	uint32 Reserved;
+	uint64 BlueprintOffset;
+	uint64 GraphOffset;
+	uint64 PinOffset;
+	uint64 PropertyOffset;
+	uint64 StringTableOffset;
+	uint64 StringDataOffset;
+	uint64 StringDataSize;
+};
+
+// 文字列テーブルの要素
+struct FBlueprintToDocBinaryString
+{
+	uint32 Offset;
+	uint32 Length;
+};
+
+// ブループリント
+struct FBlueprintToDocBinaryBlueprint
+{
+	uint32 Name;
+	uint32 ToolTips;
+	uint32 ParentName;
+	uint32 ContentPath;
+	uint32 FirstGraph;
+	uint32 GraphCount;
+	uint32 FirstProperty;
+	uint32 PropertyCount;
+	int64 HardReferenceDiskSize;
+	int64 HardReferenceMemorySize;
+	int32 HardReferenceCount;
+	int32 ReplicatedSize;
+	int32 InstanceSize;
+	uint32 Reserved;
+};
+
+// グラフ
+struct FBlueprintToDocBinaryGraph
+{
+	uint32 Name;
+	uint32 Parent;
+	uint32 Category;
+	uint32 ToolTips;
+	uint64 Flag;
+	uint32 Kind;
+	uint32 FirstPin;
+	uint32 InputCount;
+	uint32 OutputCount;
+	int32 NodeCount;
+	int32 HotNodeCount;
+};
+
+// ピン
+struct FBlueprintToDocBinaryPin
+{
+	uint32 Name;
+	uint32 Type;
+	uint32 DefaultValue;
+	uint32 ToolTips;
+};
+
+// プロパティ
+struct FBlueprintToDocBinaryProperty
+{
+	uint32 Name;
+	uint32 Type;
+	uint32 Category;
+	uint32 DefaultValue;
+	uint32 ToolTips;
+	uint32 LifetimeCondition;
+	int64 PropertyFlg;
+	int32 Size;
+	int32 ReplicatedSize;
+};
+
+static_assert(sizeof(FBlueprintToDocBinaryHeader) == 88, "BlueprintToDoc binary layout changed");
+static_assert(sizeof(FBlueprintToDocBinaryBlueprint) == 64, "BlueprintToDoc binary layout changed");
+static_assert(sizeof(FBlueprintToDocBinaryGraph) == 48, "BlueprintToDoc binary layout changed");
+static_assert(sizeof(FBlueprintToDocBinaryPin) == 16, "BlueprintToDoc binary layout changed");
+static_assert(sizeof(FBlueprintToDocBinaryProperty) == 40, "BlueprintToDoc binary layout changed");
+
+/**
+ * バイナリ形式の読み込み
+ * ファイルをメモリマップして、解析やメモリ確保をせずにレコードを参照する
+ */
+class BLUEPRINTTODOC_API FBlueprintToDocBinaryReader
+{
+public:
+	FBlueprintToDocBinaryReader();
+	~FBlueprintToDocBinaryReader();
+
+	// ファイルを開く
+	bool Open(const TCHAR* Filename);
+	// ファイルを閉じる
+	void Close();
+	// 開いているか
+	bool IsValid() const { return Header != nullptr; }
+
+	// 全ブループリント
+	TArrayView<const FBlueprintToDocBinaryBlueprint> GetBlueprints() const;
+	// ブループリントのグラフ
+	TArrayView<const FBlueprintToDocBinaryGraph> GetGraphs(const FBlueprintToDocBinaryBlueprint& Blueprint) const;
+	// ブループリントのプロパティ
+	TArrayView<const FBlueprintToDocBinaryProperty> GetProperties(const FBlueprintToDocBinaryBlueprint& Blueprint) const;
+	// グラフの入力ピン
+	TArrayView<const FBlueprintToDocBinaryPin> GetInputPins(const FBlueprintToDocBinaryGraph& Graph) const;
+	// グラフの出力ピン
+	TArrayView<const FBlueprintToDocBinaryPin> GetOutputPins(const FBlueprintToDocBinaryGraph& Graph) const;
+
+	// 文字列(UTF-8)
+	const ANSICHAR* GetString(uint32 Index) const;
+	// 文字列のバイト数
+	int32 GetStringLength(uint32 Index) const;
+
+private:
+	template<typename T>
+	const T* GetSection(uint64 Offset) const { return reinterpret_cast<const T*>(Data + Offset); }
+
+	// 範囲の確認
+	bool Validate() const;
+
+	IMappedFileHandle* MappedHandle;
+	IMappedFileRegion* MappedRegion;
+	// メモリマップできない場合の読み込み先
+	TArray<uint8> FallbackData;
+
+	const uint8* Data;
+	int64 DataSize;
+	const FBlueprintToDocBinaryHeader* Header;
+};
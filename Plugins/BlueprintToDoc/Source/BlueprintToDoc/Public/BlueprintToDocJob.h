@@ -0,0 +1,96 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetData.h"
+#include "Tickable.h"
+#include "Async/TaskGraphInterfaces.h"
+#include "BlueprintToDocUtil.h"
+
+class FBlueprintToDocLoadCost;
+class FBlueprintToDocMacroCost;
+
+/**
+ * ドキュメント化を中断・再開できるジョブ
+ * UObjectからの写し取りはゲームスレッドで1フレームあたりの時間内だけ行い、整形とページの出力はワーカースレッドに渡す
+ */
+class BLUEPRINTTODOC_API FBlueprintToDocJob : public FTickableGameObject
+{
+public:
+	// TimeBudgetSeconds が0以下なら1回のTickで全て抽出する
+	FBlueprintToDocJob(const FString& InRootPath, float InTimeBudgetSeconds);
+	virtual ~FBlueprintToDocJob();
+
+	// 抽出するアセットを集めてTickを開始する(ドライランなら数えるだけでその場で終わる)
+	bool Start();
+	// 終わるまでその場で実行する
+	void RunToCompletion();
+
+	bool IsFinished() const { return State == EState::Finished; }
+	// 抽出済みのアセットの割合
+	float GetProgress() const;
+	const FDocument& GetDocument() const { return Document; }
+	// 終了時に表示するメッセージ
+	FString GetResultMessage() const;
+
+	// 全ての出力が終わったときに呼ばれる
+	FSimpleDelegate& OnFinished() { return FinishedDelegate; }
+
+	// FTickableGameObject
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override { return State != EState::Idle && State != EState::Finished; }
+	virtual bool IsTickableInEditor() const override { return true; }
+	virtual bool IsTickableWhenPaused() const override { return true; }
+	virtual TStatId GetStatId() const override;
+
+private:
+	enum class EState : uint8
+	{
+		Idle,
+		Extracting,
+		WaitingForPages,
+		Finished,
+	};
+
+	// 期限まで抽出を進める(終わったらtrue)
+	bool ExtractUntil(double EndTime);
+	// 次に抽出するアセットから PrefetchAssetCount 個先まで非同期ロードを発行する
+	void PrefetchAssets();
+	// 抽出するアセットの非同期ロードを期限まで待つ(ロード済みならtrue)
+	bool WaitForAsset(int32 AssetIndex, double EndTime);
+	// ページ出力の完了を待たずに確認する
+	bool ArePagesWritten() const;
+	// 目次、レポート、データを出力
+	void Finish();
+
+	FDocument Document;
+	float TimeBudgetSeconds;
+	EState State;
+
+	TArray<FAssetData> Assets;
+	int32 NextAssetIndex;
+	// 非同期ロードの要求(アセットの順、要求していなければINDEX_NONE)
+	TArray<int32> LoadRequestIds;
+	int32 NextPrefetchIndex;
+	int32 PrefetchAssetCount;
+	// ユーザー定義の構造体、enum(ブループリントの後に抽出する)
+	TArray<FAssetData> TypeAssets;
+	int32 NextTypeIndex;
+
+	TUniquePtr<FBlueprintToDocLoadCost> LoadCost;
+	TUniquePtr<FBlueprintToDocMacroCost> MacroCost;
+	// 実行の結果に出す経過時間
+	double StartTime;
+	// 描画中のバッファをアリーナから確保したか(実行の結果に出す)
+	bool bUseRenderArena;
+	// ドライランで選択されたアセットの数(ドライランでなければINDEX_NONE)
+	int32 DryRunAssetCount;
+
+	// ワーカースレッドで整形するブループリント(アセットの順)
+	TArray<TSharedPtr<FBlueprintDocument, ESPMode::ThreadSafe>> BlueprintDocuments;
+	// 整形とページの出力タスク
+	FGraphEventArray PageTasks;
+
+	FSimpleDelegate FinishedDelegate;
+};
@@ -0,0 +1,86 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetData.h"
+#include "Containers/LruCache.h"
+#include "HAL/ThreadSafeBool.h"
+#include "HAL/ThreadSafeCounter.h"
+#include "BlueprintToDocUtil.h"
+
+class FSocket;
+class FTcpListener;
+class FBlueprintToDocLoadCost;
+class FBlueprintToDocMacroCost;
+struct FIPv4Endpoint;
+
+/**
+ * ドキュメントを要求されたときに描画して返すローカルHTTPサーバ
+ * ブループリントはページを開いたときに初めて抽出し、描画したページはLRUでキャッシュする
+ */
+class BLUEPRINTTODOC_API FBlueprintToDocServer : public TSharedFromThis<FBlueprintToDocServer, ESPMode::ThreadSafe>
+{
+public:
+	FBlueprintToDocServer(int32 InPort, int32 InCachedPageCount);
+	~FBlueprintToDocServer();
+
+	// 待ち受けを開始する(ゲームスレッドから呼ぶ)
+	bool Start();
+	// 待ち受けを終了する
+	void Stop();
+
+	bool IsRunning() const { return Listener != nullptr; }
+	int32 GetPort() const { return Port; }
+
+private:
+	// 接続の受付(リスナースレッド)
+	bool HandleConnectionAccepted(FSocket* Socket, const FIPv4Endpoint& Endpoint);
+	// リクエストのパスからレスポンスを作成
+	bool HandleRequest(const FString& RequestPath, FString& OutContentType, TArray<uint8>& OutBody);
+	// blueprint/以下のページを描画
+	bool RenderPage(const FString& PageName, TArray<uint8>& OutBody);
+	// ページ名からブループリントを探す
+	int32 FindBlueprintIndex(const FString& PageName) const;
+	// ページ名から構造体、enumを探す
+	int32 FindTypeIndex(const FString& PageName) const;
+
+	// ハード参照とマクロの展開の計算を作り直す(ゲームスレッド)
+	void ResetLoadCost();
+	// アセット一覧からドキュメントの骨組みを作り直す(ゲームスレッド)
+	void ResetDocument();
+	// ブループリントを抽出する(ゲームスレッドで写し取り、呼び出したスレッドで整形する)
+	void ExtractBlueprints(const TArray<int32>& Indices);
+	// 構造体、enumを抽出する(ゲームスレッドで行い、終わるまで待つ)
+	void ExtractType(int32 Index);
+	// アセットが保存されたらそのアセットのドキュメントとページ、レポートのキャッシュを破棄
+	void HandlePackageSaved(const FString& PackageFileName, UObject* Outer);
+
+	int32 Port;
+	int32 CachedPageCount;
+	FString TemplateDirectory;
+	FTcpListener* Listener;
+	FThreadSafeBool bStopping;
+	FDelegateHandle PackageSavedHandle;
+
+	// Documentと抽出状態はリスナースレッドとゲームスレッドで共有する
+	FCriticalSection DocumentLock;
+	FDocument Document;
+	TArray<FAssetData> Assets;
+	TArray<bool> Extracted;
+	// ページ名 → Document.Blueprints のインデックス
+	TMap<FString, int32> BlueprintIndices;
+	TArray<FAssetData> TypeAssets;
+	TArray<bool> TypeExtracted;
+	// ページ名 → Document.Types のインデックス
+	TMap<FString, int32> TypeIndices;
+
+	TUniquePtr<FBlueprintToDocLoadCost> LoadCost;
+	TUniquePtr<FBlueprintToDocMacroCost> MacroCost;
+	// 作り直すたびに増やし、古いドキュメントから描画したページをキャッシュしない
+	FThreadSafeCounter DocumentGeneration;
+
+	// 描画済みページ(テンプレートに埋め込んだUTF-8)
+	FCriticalSection CacheLock;
+	TLruCache<FString, TArray<uint8>> PageCache;
+};
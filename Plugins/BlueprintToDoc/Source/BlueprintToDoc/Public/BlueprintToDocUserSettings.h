@@ -22,7 +22,111 @@ public:
 	UPROPERTY(config, EditAnywhere, Category = Path, meta = (RelativePath))
 	TArray<FName> ContentPaths;
 
+	// ドキュメント化するパッケージ名(/Game/Folder/Asset)のパターン(* と ? が使える)。空なら全て
+	UPROPERTY(config, EditAnywhere, Category = Filter)
+	TArray<FString> IncludePathPatterns;
+
+	// ドキュメント化しないパッケージ名のパターン
+	UPROPERTY(config, EditAnywhere, Category = Filter)
+	TArray<FString> ExcludePathPatterns = { TEXT("/Engine/*") };
+
+	// このクラスを継承したブループリントだけドキュメント化する(Actor、BP_Base_C等)。空なら全て
+	UPROPERTY(config, EditAnywhere, Category = Filter)
+	TArray<FName> IncludeParentClasses;
+
+	// このクラスを継承したブループリントはドキュメント化しない
+	UPROPERTY(config, EditAnywhere, Category = Filter)
+	TArray<FName> ExcludeParentClasses;
+
+	// アセットのタグの値がパターンに一致するものだけドキュメント化する(タグが無いアセットは省く)
+	UPROPERTY(config, EditAnywhere, Category = Filter)
+	TMap<FName, FString> RequiredTagValues;
+
+	// アセットのタグの値がパターンに一致したらドキュメント化しない
+	UPROPERTY(config, EditAnywhere, Category = Filter)
+	TMap<FName, FString> ExcludedTagValues;
+
+	// ドキュメント化せずに、選択されるアセットの数だけを表示する
+	UPROPERTY(config, EditAnywhere, Category = Filter)
+	bool bDryRun = false;
+
 	// 抽出するプロパティのカテゴリ
 	UPROPERTY(config, EditAnywhere, Category = Property)
 	TArray<FName> ListupCategories;
+
+	// 全プロパティの一覧をCSV(gzip)と列指向バイナリで出力する
+	UPROPERTY(config, EditAnywhere, Category = Property)
+	bool bExportPropertyTable = true;
+
+	// ドキュメント情報をSQLiteのデータベース(data/blueprints.db)に出力する
+	UPROPERTY(config, EditAnywhere, Category = Database)
+	bool bExportDatabase = false;
+
+	// ドキュメント情報をメモリマップで読めるバイナリ(data/blueprints.bpdb)に出力する
+	UPROPERTY(config, EditAnywhere, Category = Database)
+	bool bExportBinary = true;
+
+	// エディタでドキュメント化するときに1フレームで抽出に使う時間(ミリ秒)。0なら全て終わるまで止める
+	UPROPERTY(config, EditAnywhere, Category = Performance, meta = (ClampMin = "0.0"))
+	float ExtractionTimeBudgetMs = 8.0f;
+
+	// 抽出中のアセットの先に非同期ロードを発行しておくアセット数。0なら抽出するときに同期ロードする
+	UPROPERTY(config, EditAnywhere, Category = Performance, meta = (ClampMin = "0"))
+	int32 PrefetchAssetCount = 8;
+
+	// プロパティの初期値をCDOから読む。無効ならCDOを作らず、既にあるブループリントだけ読む
+	UPROPERTY(config, EditAnywhere, Category = Performance)
+	bool bReadClassDefaults = true;
+
+	// ページの描画中のバッファをスレッドごとのアリーナから確保する。無効にするとヒープから確保する(確保回数の比較用)
+	UPROPERTY(config, EditAnywhere, Category = Performance)
+	bool bUseRenderArena = true;
+
+	// エディタ起動時にドキュメントサーバ(http://127.0.0.1:ポート/)を起動する
+	UPROPERTY(config, EditAnywhere, Category = Server)
+	bool bEnableDocServer = false;
+
+	// ドキュメントサーバのポート
+	UPROPERTY(config, EditAnywhere, Category = Server, meta = (ClampMin = "1", ClampMax = "65535"))
+	int32 DocServerPort = 8080;
+
+	// ドキュメントサーバでキャッシュするページ数
+	UPROPERTY(config, EditAnywhere, Category = Server, meta = (ClampMin = "1"))
+	int32 DocServerCachedPageCount = 256;
+
+	// グラフのページにノードの配置から描画したSVGを埋め込む
+	UPROPERTY(config, EditAnywhere, Category = Graph)
+	bool bEmbedGraphSVG = true;
+
+	// ロードされていないパッケージのメモリサイズ推定に使うディスクサイズへの倍率
+	UPROPERTY(config, EditAnywhere, Category = Report, meta = (ClampMin = "0.0"))
+	float HardReferenceMemoryScale = 2.0f;
+
+	// 毎フレーム呼ばれるとみなすイベント
+	UPROPERTY(config, EditAnywhere, Category = Report)
+	TArray<FName> HotEventNames = { FName(TEXT("ReceiveTick")), FName(TEXT("Tick")), FName(TEXT("BlueprintUpdateAnimation")) };
+
+	// ホットパス内で検出するアクター検索関数
+	UPROPERTY(config, EditAnywhere, Category = Report)
+	TArray<FName> ActorSearchFunctionNames = { FName(TEXT("GetAllActorsOfClass")), FName(TEXT("GetAllActorsWithTag")), FName(TEXT("GetAllActorsWithInterface")), FName(TEXT("GetAllActorsOfClassWithTag")), FName(TEXT("GetAllWidgetsOfClass")) };
+
+	// ノードのコメントとコメントボックスから集めるTODOの目印(大文字小文字を区別する)
+	UPROPERTY(config, EditAnywhere, Category = Report)
+	TArray<FString> TodoMarkers = { TEXT("TODO"), TEXT("FIXME"), TEXT("PERF") };
+
+	// 条件なしでレプリケーションされるサイズの警告の閾値(バイト)
+	UPROPERTY(config, EditAnywhere, Category = Report, meta = (ClampMin = "0"))
+	int32 AlwaysReplicatedWarningSize = 256;
+
+	// ReliableなMulticast RPCの数の警告の閾値
+	UPROPERTY(config, EditAnywhere, Category = Report, meta = (ClampMin = "0"))
+	int32 ReliableMulticastWarningCount = 4;
+
+	// メモリレイアウトのレポートで想定するインスタンス数(ブループリント名ごと)
+	UPROPERTY(config, EditAnywhere, Category = Report)
+	TMap<FName, int32> ExpectedInstanceCounts;
+
+	// ExpectedInstanceCountsに無いブループリントのインスタンス数
+	UPROPERTY(config, EditAnywhere, Category = Report, meta = (ClampMin = "0"))
+	int32 DefaultExpectedInstanceCount = 1;
 };
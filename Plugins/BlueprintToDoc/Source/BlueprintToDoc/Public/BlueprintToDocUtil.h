@@ -5,8 +5,31 @@
 #include "CoreMinimal.h"
 #include "Kismet/BlueprintFunctionLibrary.h"
 #include "CoreNetTypes.h"
+#include "Engine/EngineTypes.h"
 #include "BlueprintToDocUtil.generated.h"
 
+class FBlueprintToDocHTMLWriter;
+
+// ファイル名ごとのページ(UTF-8)
+typedef TMap<FString, FBlueprintToDocHTMLWriter> FHTMLPages;
+
+/**
+ * シンボル表
+ * 抽出の前にアセットの一覧から作り、描画時はオブジェクトパスからページ名を引くだけにする
+ * 同じ名前のアセットがあってもページ名は重複しない
+ */
+struct FDocumentSymbolTable
+{
+	// オブジェクトパス → ページ名(拡張子なし、ブループリントは生成クラスのパスでも引ける)
+	TMap<FName, FString> PageNames;
+
+	// ページ名を探す(無ければnullptr)
+	const FString* FindPageName(FName ObjectPath) const
+	{
+		return ObjectPath.IsNone() ? nullptr : PageNames.Find(ObjectPath);
+	}
+};
+
 /**
  * イベントグラフピンドキュメント化情報
  */
@@ -17,8 +40,12 @@ struct FEdGraphPinDocument
 	// グラフ名
 	UPROPERTY()
 	FString Name;
+	// 型(同じ値が多いのでFNameで持つ)
+	UPROPERTY()
+	FName Type;
+	// 型のオブジェクトパス(構造体、enum、クラスの場合のみ)
 	UPROPERTY()
-	FString Type;
+	FName TypePath;
 	// 初期値
 	UPROPERTY()
 	FString DefaultValue;
@@ -27,6 +54,75 @@ struct FEdGraphPinDocument
 	FString ToolTips;
 };
 
+// ピンの並び(ほとんどのグラフは4本以下なのでヒープを使わない)
+typedef TArray<FEdGraphPinDocument, TInlineAllocator<4>> FEdGraphPinArray;
+
+/**
+ * グラフ描画用のピンの配置
+ */
+USTRUCT()
+struct FEdGraphPinLayout
+{
+	GENERATED_BODY()
+
+	// 表示名(実行ピンは空)
+	UPROPERTY()
+	FString Name;
+	// ピンのカテゴリ(色分けに使う)
+	UPROPERTY()
+	FName Category;
+};
+
+/**
+ * グラフ描画用のノードの配置
+ */
+USTRUCT()
+struct FEdGraphNodeLayout
+{
+	GENERATED_BODY()
+
+	// タイトル(1行目のみ)
+	UPROPERTY()
+	FString Title;
+	// 位置
+	UPROPERTY()
+	int32 X = 0;
+	UPROPERTY()
+	int32 Y = 0;
+	// 大きさ(コメントボックス等、エディタが保存している場合のみ)
+	UPROPERTY()
+	int32 Width = 0;
+	UPROPERTY()
+	int32 Height = 0;
+	// コメントボックスか
+	UPROPERTY()
+	bool bIsComment = false;
+	// 表示されているピン(定義された順)
+	UPROPERTY()
+	TArray<FEdGraphPinLayout> Inputs;
+	UPROPERTY()
+	TArray<FEdGraphPinLayout> Outputs;
+};
+
+/**
+ * グラフ描画用の接続(出力ピンから入力ピンへ)
+ */
+USTRUCT()
+struct FEdGraphWireLayout
+{
+	GENERATED_BODY()
+
+	// ノードは NodeLayouts、ピンは Outputs / Inputs のインデックス
+	UPROPERTY()
+	int32 FromNode = 0;
+	UPROPERTY()
+	int32 FromPin = 0;
+	UPROPERTY()
+	int32 ToNode = 0;
+	UPROPERTY()
+	int32 ToPin = 0;
+};
+
 /**
  * イベントグラフドキュメント化情報
  */
@@ -37,26 +133,201 @@ struct FEdGraphDocument
 	// グラフ名
 	UPROPERTY()
 	FString Name;
+	// グラフのオブジェクト名(ブループリント内で重複しない)
+	UPROPERTY()
+	FName GraphName;
 	// ペアレント
 	UPROPERTY()
-	FString Parent;
-	// カテゴリ
+	FName Parent;
+	// カテゴリ(無ければNAME_None)
 	UPROPERTY()
-	FString Category;
+	FName Category;
 	// ファンクションフラグ
 	uint64 Flag;
-	// 入力
-	UPROPERTY()
-	TMap<FString,FEdGraphPinDocument> Input;
-	// 出力
-	UPROPERTY()
-	TMap<FString,FEdGraphPinDocument> Output;
+	// 入力(定義された順、TInlineAllocatorはUPROPERTYにできない)
+	FEdGraphPinArray Input;
+	// 出力(定義された順)
+	FEdGraphPinArray Output;
 	// ToolTips
 	UPROPERTY()
 	FString ToolTips;
-	// Todo
+	// Todo(コメントの目印から行末まで)
 	UPROPERTY()
 	TArray<FString> TodoList;
+
+	// ノード数
+	UPROPERTY()
+	int32 NodeCount = 0;
+	// ホットイベント(Tick等)から実行されるノード数
+	UPROPERTY()
+	int32 HotNodeCount = 0;
+	// ホットパス内のループ(ForEach/While等のマクロ)
+	UPROPERTY()
+	int32 HotLoopCount = 0;
+	// ホットパス内のCast
+	UPROPERTY()
+	int32 HotCastCount = 0;
+	// ホットパス内のGetAllActorsOfClass等
+	UPROPERTY()
+	int32 HotActorSearchCount = 0;
+	// ピュアノードの再評価回数(接続先の実行ノードが複数ある分)
+	UPROPERTY()
+	int32 PureReevaluationCount = 0;
+	// グラフ描画用のノードと接続の配置
+	UPROPERTY()
+	TArray<FEdGraphNodeLayout> NodeLayouts;
+	UPROPERTY()
+	TArray<FEdGraphWireLayout> WireLayouts;
+};
+
+/**
+ * コンポーネントドキュメント化情報
+ * SimpleConstructionScriptのノードとテンプレートから作る(CDOは使わない)
+ */
+USTRUCT()
+struct FComponentDocument
+{
+	GENERATED_BODY()
+
+	// 変数名
+	UPROPERTY()
+	FString Name;
+	// コンポーネントのクラス
+	UPROPERTY()
+	FName ComponentClass;
+	// コンポーネントのクラスのオブジェクトパス
+	UPROPERTY()
+	FName ClassPath;
+	// アタッチ先(ルートはNAME_None)
+	UPROPERTY()
+	FName AttachParent;
+	// アタッチ先のソケット
+	UPROPERTY()
+	FName AttachSocket;
+	// ツリーの深さ
+	UPROPERTY()
+	int32 Depth = 0;
+	// 親のブループリントから継承したか
+	UPROPERTY()
+	bool bInherited = false;
+	// Tick
+	UPROPERTY()
+	bool bCanEverTick = false;
+	UPROPERTY()
+	bool bStartWithTickEnabled = false;
+	UPROPERTY()
+	float TickInterval = 0.0f;
+	// コリジョン(PrimitiveComponentのみ)
+	UPROPERTY()
+	bool bIsPrimitive = false;
+	UPROPERTY()
+	FName CollisionProfile;
+	UPROPERTY()
+	TEnumAsByte<ECollisionEnabled::Type> CollisionEnabled = ECollisionEnabled::NoCollision;
+	UPROPERTY()
+	bool bGenerateOverlapEvents = false;
+};
+
+/**
+ * アニメーショングラフのノードのドキュメント化情報
+ * 入力ピンの接続元から、プロパティアクセスの高速パスで読めるかを判定する
+ */
+USTRUCT()
+struct FAnimNodeDocument
+{
+	GENERATED_BODY()
+
+	// ノードのタイトル
+	UPROPERTY()
+	FString Title;
+	// ノードのあるグラフ(AnimGraph/ステートマシン/ステート)
+	UPROPERTY()
+	FString GraphPath;
+	// 接続された入力ピンの数(ポーズは除く)
+	UPROPERTY()
+	int32 BoundPinCount = 0;
+	// 高速パスで読めずにブループリントVMで評価される入力ピンの数
+	UPROPERTY()
+	int32 SlowPathPinCount = 0;
+	// 入力の評価で呼ばれるスレッドセーフでない関数
+	UPROPERTY()
+	TArray<FString> ThreadUnsafeCalls;
+};
+
+/**
+ * ステートマシンのステートのドキュメント化情報
+ */
+USTRUCT()
+struct FAnimStateDocument
+{
+	GENERATED_BODY()
+
+	// ステートマシン(AnimGraph/ステートマシン)
+	UPROPERTY()
+	FString StateMachine;
+	// ステート名
+	UPROPERTY()
+	FString Name;
+	// ステート内のノード数(ネストしたステートマシンを含む)
+	UPROPERTY()
+	int32 NodeCount = 0;
+	// 高速パスで読めない入力があるノード数
+	UPROPERTY()
+	int32 SlowPathNodeCount = 0;
+	// このステートから出る遷移の数
+	UPROPERTY()
+	int32 TransitionCount = 0;
+};
+
+/**
+ * ウィジェットのプロパティバインドのドキュメント化情報
+ * バインドは毎フレーム評価される
+ */
+USTRUCT()
+struct FWidgetBindingDocument
+{
+	GENERATED_BODY()
+
+	// バインドしたウィジェット
+	UPROPERTY()
+	FString Widget;
+	// バインドしたプロパティ(Text、Visibility等)
+	UPROPERTY()
+	FName Property;
+	// 関数のバインドの関数名(プロパティのバインドはNAME_None)
+	UPROPERTY()
+	FName FunctionName;
+	// プロパティのバインドの参照先
+	UPROPERTY()
+	FString SourcePath;
+};
+
+/**
+ * ブループリントでのマクロの使用のドキュメント化情報
+ * インスタンスはコンパイル時に展開したノード数だけコードを増やす
+ */
+USTRUCT()
+struct FMacroUsageDocument
+{
+	GENERATED_BODY()
+
+	// マクロ名
+	UPROPERTY()
+	FString Name;
+	// マクロのグラフのパス(ブループリントをまたいで集計する)
+	UPROPERTY()
+	FName MacroPath;
+	// マクロを定義したブループリント(マクロライブラリ等)
+	UPROPERTY()
+	FName Library;
+	UPROPERTY()
+	FName LibraryPath;
+	// イベントグラフと関数にあるインスタンスの数
+	UPROPERTY()
+	int32 InstanceCount = 0;
+	// 1回展開したときのノード数(入れ子のマクロも展開する)
+	UPROPERTY()
+	int32 ExpandedNodeCount = 0;
 };
 
 /**
@@ -72,10 +343,13 @@ struct FPropertyDocument
 	FString Name;
 	// タイプ
 	UPROPERTY()
-	FString Type;
-	// カテゴリ
+	FName Type;
+	// 型のオブジェクトパス(構造体、enum、クラスの場合のみ)
+	UPROPERTY()
+	FName TypePath;
+	// カテゴリ(無ければNAME_None)
 	UPROPERTY()
-	FString Category;
+	FName Category;
 	// プロパティフラグ
 	int64 PropertyFlg;
 	// 初期値
@@ -87,6 +361,21 @@ struct FPropertyDocument
 	// LifeTimeCondition
 	UPROPERTY()
 	TEnumAsByte<ELifetimeCondition> LifetimeCondition;
+	// サイズ
+	UPROPERTY()
+	int32 Size = 0;
+	// インスタンス内のオフセット
+	UPROPERTY()
+	int32 Offset = 0;
+	// アラインメント
+	UPROPERTY()
+	int32 Alignment = 0;
+	// コンテナの要素数(初期値から分かる場合のみ)
+	UPROPERTY()
+	int32 ElementCount = INDEX_NONE;
+	// レプリケーションで送られる推定バイト数
+	UPROPERTY()
+	int32 ReplicatedSize = 0;
 };
 
 /**
@@ -100,12 +389,19 @@ struct FBlueprintDocument
 	// Blueprint名
 	UPROPERTY()
 	FString Name;
+	// ページ名(シンボル表で決めた重複しない名前)
+	UPROPERTY()
+	FString PageName;
 	// ToopTips
 	UPROPERTY()
 	FString ToolTips;
 	// Parentクラス
 	UPROPERTY()
 	FString ParentName;
+	// Parentクラスのオブジェクトパス
+	UPROPERTY()
+	FName ParentPath;
+
 	// ContentPath
 	UPROPERTY()
 	FString ContentPath;
@@ -118,12 +414,115 @@ struct FBlueprintDocument
 	// Functions
 	UPROPERTY()
 	TArray<FEdGraphDocument> Functions;
-	// Component
+	// Component(ツリーの深さ優先の順、親のブループリントのものが先)
 	UPROPERTY()
-	TArray<FEdGraphDocument> Components;
+	TArray<FComponentDocument> Components;
 	// Property
 	UPROPERTY()
 	TArray<FPropertyDocument> Properties;
+	// ハード参照しているパッケージ数(自身を含む)
+	UPROPERTY()
+	int32 HardReferenceCount = 0;
+	// ハード参照のディスクサイズ
+	UPROPERTY()
+	int64 HardReferenceDiskSize = 0;
+	// ハード参照の推定メモリサイズ
+	UPROPERTY()
+	int64 HardReferenceMemorySize = 0;
+	// アクターか
+	UPROPERTY()
+	bool bIsActor = false;
+	// レプリケーションの推定バイト数
+	UPROPERTY()
+	int32 ReplicatedSize = 0;
+	// 条件なしでレプリケーションされる推定バイト数
+	UPROPERTY()
+	int32 AlwaysReplicatedSize = 0;
+	// RPCの数
+	UPROPERTY()
+	int32 RPCCount = 0;
+	// ReliableなMulticast RPCの数
+	UPROPERTY()
+	int32 ReliableMulticastCount = 0;
+	// インスタンスサイズ
+	UPROPERTY()
+	int32 InstanceSize = 0;
+	// このクラスで追加したプロパティのパディング
+	UPROPERTY()
+	int32 PaddingSize = 0;
+	// プロパティを並べ替えた場合のインスタンスサイズ
+	UPROPERTY()
+	int32 OptimizedInstanceSize = 0;
+	// パディングが最小になるプロパティの並び順
+	UPROPERTY()
+	TArray<FString> SuggestedPropertyOrder;
+	// アニメーションブループリントか
+	UPROPERTY()
+	bool bIsAnimBlueprint = false;
+	// アニメーションの更新をワーカースレッドで行うか
+	UPROPERTY()
+	bool bUseMultiThreadedAnimationUpdate = false;
+	// アニメーショングラフのノード
+	UPROPERTY()
+	TArray<FAnimNodeDocument> AnimNodes;
+	// ステートマシンのステート
+	UPROPERTY()
+	TArray<FAnimStateDocument> AnimStates;
+	// ウィジェットブループリントか
+	UPROPERTY()
+	bool bIsWidgetBlueprint = false;
+	// プロパティのバインド
+	UPROPERTY()
+	TArray<FWidgetBindingDocument> WidgetBindings;
+	// Tickをブループリントで実装したウィジェット(自身と階層内のユーザーウィジェット)
+	UPROPERTY()
+	TArray<FString> WidgetTickOverrides;
+	// 階層内のウィジェット数
+	UPROPERTY()
+	int32 WidgetCount = 0;
+	// 階層の深さ
+	UPROPERTY()
+	int32 WidgetTreeDepth = 0;
+	// Volatileなウィジェット数
+	UPROPERTY()
+	int32 VolatileWidgetCount = 0;
+	// InvalidationBoxの数
+	UPROPERTY()
+	int32 InvalidationBoxCount = 0;
+	// RetainerBoxの数
+	UPROPERTY()
+	int32 RetainerBoxCount = 0;
+	// 使用しているマクロ(展開したノード数の合計が多い順)
+	UPROPERTY()
+	TArray<FMacroUsageDocument> MacroUsages;
+};
+
+/**
+ * ユーザー定義の構造体、enumのドキュメント化情報
+ */
+USTRUCT()
+struct FTypeDocument
+{
+	GENERATED_BODY()
+
+	// 型名
+	UPROPERTY()
+	FString Name;
+	// ページ名
+	UPROPERTY()
+	FString PageName;
+	// ContentPath
+	UPROPERTY()
+	FString ContentPath;
+	// ToolTips
+	UPROPERTY()
+	FString ToolTips;
+	// enumか
+	UPROPERTY()
+	bool bIsEnum = false;
+	// メンバー(構造体は変数、enumは名前と値)
+	UPROPERTY()
+	TArray<FPropertyDocument> Members;
 };
 
 /**
@@ -141,6 +540,16 @@ struct FDocument
 	// ブループリント
 	UPROPERTY()
 	TArray<FBlueprintDocument> Blueprints;
+
+	// ユーザー定義の構造体、enum
+	UPROPERTY()
+	TArray<FTypeDocument> Types;
+
+	// シンボル表(作り直すまで変更しないのでワーカースレッドと共有する)
+	TSharedPtr<const FDocumentSymbolTable, ESPMode::ThreadSafe> Symbols;
+
+	// シンボル表(無ければ空の表)
+	const FDocumentSymbolTable& GetSymbols() const;
 };
 
 /**
@@ -155,27 +564,126 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "BlueprintToDoc")
 	static void BlueprintToDoc();
 
-	static void BlueprintToDoc_Exec(FDocument& Document);
+	// ドキュメント化するアセットを選択だけして数を返す(ロードしない)
+	UFUNCTION(BlueprintCallable, Category = "BlueprintToDoc")
+	static int32 BlueprintToDocDryRun();
+
+	// 終わるまで実行し、終了時に表示するメッセージを返す
+	static FString BlueprintToDoc_Exec(FDocument& Document);
+
+	// ドキュメントのFNameを文字列にする(NAME_Noneは空文字)
+	static FString NameToString(FName Name);
+	// ドキュメントのFNameの並び順(NAME_Noneが先頭、同じ名前は文字列を比較しない)
+	static bool NameLess(FName A, FName B);
 
 private:
-	// EdGraphから情報を取得する
-	static void MakeEdGraphDocument(TArray<FEdGraphDocument>& OutEdGraphDocument, class UBlueprint* Blueprint, const TArray<class UEdGraph*>& EdGraphs);
-
-	// ドキュメント情報からHTMLを出力
-	static void DocumentToHTML(FDocument& Document);
-	// 見出し
-	static void TopicHTML(FString& OutString, int32 Level, const FString& Contents);
-	// 改行の置換
-	static FString ReplaceHTMLReturenCode(const FString& Source);
+	friend class FBlueprintToDocServer;
+	friend class FBlueprintToDocJob;
+
+	// ドキュメント化するアセットを取得する
+	static bool GetBlueprintAssets(TArray<struct FAssetData>& OutAssetData);
+	// ドキュメント化するユーザー定義の構造体、enumを取得する
+	static bool GetTypeAssets(TArray<struct FAssetData>& OutAssetData);
+	// アセットの一覧からシンボル表を作る
+	static void MakeSymbolTable(FDocumentSymbolTable& OutSymbols, const TArray<struct FAssetData>& BlueprintAssets, const TArray<struct FAssetData>& TypeAssets);
+	// アセットから加工前の情報を写し取る(ゲームスレッド)
+	static bool MakeBlueprintSnapshot(struct FBlueprintSnapshot& OutSnapshot, const struct FAssetData& AssetData, const FDocumentSymbolTable& Symbols, class FBlueprintToDocLoadCost& LoadCost, class FBlueprintToDocMacroCost& MacroCost);
+	// ユーザー定義の構造体、enumのドキュメントを作る(ゲームスレッド)
+	static bool MakeTypeDocument(FTypeDocument& OutTypeDocument, const struct FAssetData& AssetData, const FDocumentSymbolTable& Symbols);
+	// SimpleConstructionScriptからコンポーネントのツリーを取得する(ゲームスレッド)
+	static void MakeComponentDocuments(TArray<FComponentDocument>& OutComponentDocuments, class UBlueprint* Blueprint);
+	// アニメーショングラフのノードとステートを取得する(ゲームスレッド)
+	static void MakeAnimBlueprintDocument(FBlueprintDocument& OutBlueprintDocument, class UAnimBlueprint* AnimBlueprint);
+	// ウィジェットのバインド、階層、Tickを取得する(ゲームスレッド)
+	static void MakeWidgetBlueprintDocument(FBlueprintDocument& OutBlueprintDocument, class UWidgetBlueprint* WidgetBlueprint);
+	// イベントグラフと関数で使われたマクロと展開したノード数を取得する(ゲームスレッド)
+	static void MakeMacroUsages(TArray<FMacroUsageDocument>& OutMacroUsages, class UBlueprint* Blueprint, class FBlueprintToDocMacroCost& MacroCost);
+	// EdGraphから加工前の情報を写し取る(ゲームスレッド)
+	static void MakeEdGraphSnapshot(TArray<struct FEdGraphSnapshot>& OutEdGraphSnapshot, class UBlueprint* Blueprint, const TArray<class UEdGraph*>& EdGraphs);
+	// 写し取った情報を整形する(どのスレッドからでも呼べる)
+	static void FormatBlueprintSnapshot(FBlueprintDocument& OutBlueprintDocument, const struct FBlueprintSnapshot& Snapshot);
+	static void FormatEdGraphSnapshot(TArray<FEdGraphDocument>& OutEdGraphDocument, const TArray<struct FEdGraphSnapshot>& EdGraphSnapshots, const TArray<FString>& TodoMarkers);
+	// このクラスで追加したプロパティのメモリレイアウトを調べる
+	static void MakeMemoryLayout(FBlueprintDocument& OutBlueprintDocument, const class UClass* Class);
+	// プロパティのレプリケーションの推定バイト数
+	static int32 EstimateReplicatedSize(const class UProperty* Property, const void* ValuePtr);
+	// EdGraphの実行コストの指標を取得する
+	static void MakeEdGraphCost(FEdGraphDocument& OutEdGraphDocument, class UEdGraph* EdGraph);
+	// EdGraphのノードと接続の配置を取得する(描画はワーカースレッドで行う)
+	static void MakeEdGraphLayout(FEdGraphDocument& OutEdGraphDocument, class UEdGraph* EdGraph);
+
+	// 目次とレポートのHTMLを出力し、共通のファイルをコピー
+	static void IndexToHTML(FDocument& Document);
+	// ドキュメント情報をデータファイルに出力
+	static void ExportData(const FDocument& Document);
+	// HTMLテンプレートのディレクトリ
+	static FString GetHTMLTemplateDirectory();
+	// 目次のページ作成
+	static void TOCPageHTML(FBlueprintToDocHTMLWriter& OutHTML, const FDocument& Document);
+	// ブループリントのページとグラフのページ作成
+	static void BlueprintPageHTML(FHTMLPages& OutPages, const FBlueprintDocument& BlueprintDocument, const FDocumentSymbolTable& Symbols);
+	// 構造体、enumのページ作成
+	static void TypePageHTML(FBlueprintToDocHTMLWriter& OutHTML, const FTypeDocument& TypeDocument, const FDocumentSymbolTable& Symbols);
+	// レポートのページ作成
+	static void ReportPagesHTML(FHTMLPages& OutPages, const FDocument& Document);
+	// レポートのページ名(描画せずに求める)
+	static void GetReportPageNames(TArray<FString>& OutPageNames);
+	// ページをファイルに出力
+	static void SaveHTMLPages(const FString& RootPath, const FHTMLPages& Pages);
+	// 見出し(FStringはエスケープする)
+	static void TopicHTML(FBlueprintToDocHTMLWriter& OutHTML, int32 Level, const FString& Contents);
+	static void TopicHTML(FBlueprintToDocHTMLWriter& OutHTML, int32 Level, const ANSICHAR* Contents);
+	// エスケープしたテキストのセルを追加
+	static void AddCell(FBlueprintToDocHTMLWriter& OutHTML, const FString& Contents);
+	static void AddCell(FBlueprintToDocHTMLWriter& OutHTML, FName Contents);
+	// 組み立て済みのHTMLのセルを追加
+	static void AddCell(FBlueprintToDocHTMLWriter& OutHTML, const FBlueprintToDocHTMLWriter& Contents);
+	// 数値のセルを追加
+	static void AddIntCell(FBlueprintToDocHTMLWriter& OutHTML, int64 Value);
+	// ドキュメント内のリンクを追加
+	static void AddLink(FBlueprintToDocHTMLWriter& OutHTML, const FString& FileName, const FString& Label);
+	static void AddLinkCell(FBlueprintToDocHTMLWriter& OutHTML, const FString& FileName, const FString& Label);
+	// 型名を追加(シンボル表にあれば定義へのリンクにする)
+	static void AddType(FBlueprintToDocHTMLWriter& OutHTML, FName Type, FName TypePath, const FDocumentSymbolTable& Symbols);
+	static void AddTypeCell(FBlueprintToDocHTMLWriter& OutHTML, FName Type, FName TypePath, const FDocumentSymbolTable& Symbols);
 	// 条件による１行追加
-	static void AddLine(FString& OutString, bool Result, FString AddString);
+	static void AddLine(FBlueprintToDocHTMLWriter& OutHTML, bool Result, const FString& AddString);
+	// EdGraphのHTMLファイル名("<ブループリントのページ名>.<グラフ名>.html")
+	static FString EdGraphHTMLFileName(const FBlueprintDocument& BlueprintDocument, const FEdGraphDocument& EdGraphDocument);
 	// EdGraphをHTMLへ
-	static void EdGraphTableHTML(FString& OutString, const TArray<FEdGraphDocument>& EdGraphDocuments,FDocument& Document);
+	static void EdGraphTableHTML(FBlueprintToDocHTMLWriter& OutHTML, const FBlueprintDocument& BlueprintDocument, const TArray<FEdGraphDocument>& EdGraphDocuments, const FDocumentSymbolTable& Symbols, FHTMLPages& OutPages);
+	// ComponentをHTMLへ
+	static void ComponentsTableHTML(FBlueprintToDocHTMLWriter& OutHTML, const TArray<FComponentDocument>& ComponentDocuments, const FDocumentSymbolTable& Symbols);
+	// アニメーショングラフのノードとステートをHTMLへ
+	static void AnimGraphTableHTML(FBlueprintToDocHTMLWriter& OutHTML, const FBlueprintDocument& BlueprintDocument);
+	// ウィジェットのバインドと階層をHTMLへ
+	static void WidgetTableHTML(FBlueprintToDocHTMLWriter& OutHTML, const FBlueprintDocument& BlueprintDocument);
+	// マクロの使用をHTMLへ
+	static void MacroUsagesTableHTML(FBlueprintToDocHTMLWriter& OutHTML, const TArray<FMacroUsageDocument>& MacroUsages, const FDocumentSymbolTable& Symbols);
 	// PropertyをHTML
-	static void PropertiesTableHTML(FString& OutString, const TArray<FPropertyDocument>& PropertiesDocuments);
+	static void PropertiesTableHTML(FBlueprintToDocHTMLWriter& OutHTML, const TArray<FPropertyDocument>& PropertiesDocuments, const FDocumentSymbolTable& Symbols);
+
 	// カテゴリのページ作成
-	static void CategoryPageHTML(FDocument& Document, FName Category);
-	// ELifetimeConditionの文字列取得
-	static FString LifetimeConditionToString(ELifetimeCondition Condition);
+	static void CategoryPageHTML(FBlueprintToDocHTMLWriter& OutHTML, const FDocument& Document, FName Category);
+	// ハード参照の重いブループリントのページ作成
+	static void HeavyBlueprintPageHTML(FBlueprintToDocHTMLWriter& OutHTML, const FDocument& Document);
+	// 実行コストの高いグラフのページ作成
+	static void HotspotPageHTML(FBlueprintToDocHTMLWriter& OutHTML, const FDocument& Document);
+	// レプリケーションの推定バイト数のページ作成
+	static void ReplicationPageHTML(FBlueprintToDocHTMLWriter& OutHTML, const FDocument& Document);
+	// メモリレイアウトのページ作成
+	static void MemoryLayoutPageHTML(FBlueprintToDocHTMLWriter& OutHTML, const FDocument& Document);
+	// TODOのページ作成
+	static void TodoPageHTML(FBlueprintToDocHTMLWriter& OutHTML, const FDocument& Document);
+	// アニメーションブループリントの更新コストのページ作成
+	static void AnimBlueprintPageHTML(FBlueprintToDocHTMLWriter& OutHTML, const FDocument& Document);
+	// ウィジェットブループリントの毎フレームのコストのページ作成
+	static void WidgetBlueprintPageHTML(FBlueprintToDocHTMLWriter& OutHTML, const FDocument& Document);
+	// マクロの展開コストのページ作成
+	static void MacroExpansionPageHTML(FBlueprintToDocHTMLWriter& OutHTML, const FDocument& Document);
+	// 想定するインスタンス数の取得
+	static int32 GetExpectedInstanceCount(const FBlueprintDocument& BlueprintDocument);
+	// バイト数の文字列取得
+	static FString SizeToString(int64 Size);
 
 };
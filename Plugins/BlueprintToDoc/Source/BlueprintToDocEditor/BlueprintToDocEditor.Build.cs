@@ -44,6 +44,7 @@ public class BlueprintToDocEditor : ModuleRules
 				"Slate",
 				"SlateCore",
 				"BlueprintToDoc",
+				"AssetRegistry",
 				// ... add private dependencies that you statically link with here ...	
 			}
 			);
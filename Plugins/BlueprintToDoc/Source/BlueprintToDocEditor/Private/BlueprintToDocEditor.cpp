@@ -9,6 +9,9 @@
 #include "LevelEditor.h"
 #include "BlueprintToDocUtil.h"
 #include "BlueprintToDocUserSettings.h"
+#include "BlueprintToDocServer.h"
+#include "BlueprintToDocJob.h"
+#include "AssetRegistryModule.h"
 #include <ISettingsModule.h>
 
 
@@ -50,12 +53,38 @@ void FBlueprintToDocEditorModule::StartupModule()
 	}
 
 	RegisterSettings();
+
+	// ドキュメントサーバはアセットの検索が終わってから起動する
+	const UBlueprintToDocUserSettings* Settings = GetDefault<UBlueprintToDocUserSettings>();
+	if(Settings->bEnableDocServer)
+	{
+		IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(FName("AssetRegistry")).Get();
+		if(AssetRegistry.IsLoadingAssets())
+		{
+			AssetRegistry.OnFilesLoaded().AddRaw(this, &FBlueprintToDocEditorModule::StartDocServer);
+		}
+		else
+		{
+			StartDocServer();
+		}
+	}
 }
 
 void FBlueprintToDocEditorModule::ShutdownModule()
 {
 	// This function may be called during shutdown to clean up your module.  For modules that support dynamic reloading,
 	// we call this function before unloading the module.
+	if(FAssetRegistryModule* AssetRegistryModule = FModuleManager::GetModulePtr<FAssetRegistryModule>(FName("AssetRegistry")))
+	{
+		AssetRegistryModule->Get().OnFilesLoaded().RemoveAll(this);
+	}
+	if(DocServer.IsValid())
+	{
+		DocServer->Stop();
+		DocServer.Reset();
+	}
+	DocumentJob.Reset();
+
 	FBlueprintToDocStyle::Shutdown();
 
 	FBlueprintToDocCommands::Unregister();
@@ -86,11 +115,39 @@ void FBlueprintToDocEditorModule::PluginButtonClicked()
 		FPaths::NormalizeDirectoryName(Document.RootPath);
 	}
 
-	// ドキュメント化実行
-	UBlueprintToDocUtil::BlueprintToDoc_Exec(Document);
+	// 実行中なら何もしない
+	if(DocumentJob.IsValid() && !DocumentJob->IsFinished())
+	{
+		return;
+	}
+
+	// ドキュメント化実行(数フレームに分けて抽出する。ドライランはその場で終わる)
+	DocumentJob = MakeShared<FBlueprintToDocJob>(Document.RootPath, Settings->ExtractionTimeBudgetMs / 1000.0f);
+	TWeakPtr<FBlueprintToDocJob> WeakJob = DocumentJob;
+	DocumentJob->OnFinished().BindLambda([WeakJob]()
+	{
+		// 終了を通知
+		if(TSharedPtr<FBlueprintToDocJob> Job = WeakJob.Pin())
+		{
+			FPlatformMisc::MessageBoxExt(EAppMsgType::Ok, *Job->GetResultMessage(), TEXT("BlueprintToDoc"));
+		}
+	});
+	if(!DocumentJob->Start())
+	{
+		DocumentJob.Reset();
+	}
+}
+
+void FBlueprintToDocEditorModule::StartDocServer()
+{
+	const UBlueprintToDocUserSettings* Settings = GetDefault<UBlueprintToDocUserSettings>();
+	check(Settings);
 
-	// 終了を通知
-	FPlatformMisc::MessageBoxExt(EAppMsgType::Ok, TEXT("Finish！！ BlueprintToDoc"), TEXT("BlueprintToDoc"));
+	DocServer = MakeShared<FBlueprintToDocServer, ESPMode::ThreadSafe>(Settings->DocServerPort, Settings->DocServerCachedPageCount);
+	if(!DocServer->Start())
+	{
+		DocServer.Reset();
+	}
 }
 
 void FBlueprintToDocEditorModule::AddMenuExtension(FMenuBuilder& Builder)
@@ -1,4 +1,4 @@
-// Copyright 1998-2017 Epic Games, Inc. All Rights Reserved.
+﻿// Copyright 1998-2017 Epic Games, Inc. All Rights Reserved.
 
 #pragma once
 
@@ -7,6 +7,8 @@
 
 class FToolBarBuilder;
 class FMenuBuilder;
+class FBlueprintToDocServer;
+class FBlueprintToDocJob;
 
 class FBlueprintToDocEditorModule : public IModuleInterface
 {
@@ -27,6 +29,12 @@ private:
 	void RegisterSettings();
 	void UnregisterSettings();
 
+	// ドキュメントサーバの起動
+	void StartDocServer();
+
 private:
 	TSharedPtr<class FUICommandList> PluginCommands;
+	TSharedPtr<FBlueprintToDocServer, ESPMode::ThreadSafe> DocServer;
+	// 終了後も次に実行するまで保持する(Tick中に破棄しないため)
+	TSharedPtr<FBlueprintToDocJob> DocumentJob;
 };
\ No newline at end of file